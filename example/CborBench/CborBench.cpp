@@ -0,0 +1,104 @@
+/*!
+ * \file CborBench.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * Size and speed of CBOR against JSON text, usage (from the top level directory):
+ *   CborBench-release [records] [repeat]
+ */
+
+#include <json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+static std::string read_file(const std::string& path) {
+    std::ifstream stream(path.c_str(), std::ios::in | std::ios::binary);
+    std::ostringstream oss;
+    oss << stream.rdbuf();
+    return oss.str();
+}
+
+static std::string make_document(size_t records) {
+    std::ostringstream oss;
+    oss << "[";
+    for (size_t i = 0; i < records; ++i) {
+        oss << (i ? "," : "")
+            << "{\"id\":" << i
+            << ",\"name\":\"record number " << i << "\""
+            << ",\"score\":" << (i % 1000) / 10.0
+            << ",\"active\":" << (i % 2 ? "true" : "false")
+            << ",\"tags\":[\"alpha\",\"beta\",\"gamma\"]"
+            << ",\"owner\":{\"id\":" << i % 97 << ",\"email\":\"user" << i % 97 << "@example.com\"}}";
+    }
+    oss << "]";
+    return oss.str();
+}
+
+/* best time of `repeat` runs, each one calling `f` `times` times */
+template <typename Function> static double measure(Function f, int repeat, int times) {
+    double best = 0;
+    for (int r = 0; r < repeat; ++r) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < times; ++i) {
+            f();
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / times;
+        best = (r == 0 || elapsed < best) ? elapsed : best;
+    }
+    return best;
+}
+
+static void compare(const std::string& name, const std::string& spec, int repeat) {
+    // small documents are encoded and decoded many times per run
+    int times = static_cast<int>(std::max<size_t>(1, (1 << 20) / spec.size()));
+
+    Json value = json::parse(spec);
+    std::string text = value.stringify();
+    std::vector<uint8_t> cbor = json::to_cbor(value);
+
+    double stringify = measure([&]() { value.stringify(); }, repeat, times);
+    double to_cbor = measure([&]() { json::to_cbor(value); }, repeat, times);
+    double parse = measure([&]() { json::parse(text); }, repeat, times);
+    double from_cbor = measure([&]() { json::from_cbor(cbor); }, repeat, times);
+
+    std::cout << std::setw(24) << name
+              << std::setw(12) << text.size() << std::setw(12) << cbor.size()
+              << std::setw(12) << std::setprecision(1) << stringify * 1e6
+              << std::setw(12) << to_cbor * 1e6
+              << std::setw(12) << parse * 1e6
+              << std::setw(12) << from_cbor * 1e6 << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    size_t records = argc > 1 ? static_cast<size_t>(atol(argv[1])) : 100000;
+    int repeat = argc > 2 ? atoi(argv[2]) : 3;
+
+    std::cout << std::fixed
+              << std::setw(24) << "document"
+              << std::setw(12) << "text B" << std::setw(12) << "CBOR B"
+              << std::setw(12) << "stringify" << std::setw(12) << "to_cbor"
+              << std::setw(12) << "parse" << std::setw(12) << "from_cbor"
+              << "   (us)" << std::endl;
+
+    const char *samples[] = { "test/samples/1.glossary.json", "test/samples/2.web_app.json" };
+    for (size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); ++i) {
+        std::string spec = read_file(samples[i]);
+        if (spec.empty()) {
+            std::cerr << "Unable to read " << samples[i] << ", run from the top level directory" << std::endl;
+            return 1;
+        }
+        compare(samples[i] + sizeof("test/samples/") - 1, spec, repeat);
+    }
+
+    std::ostringstream name;
+    name << records << " records";
+    compare(name.str(), make_document(records), repeat);
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+/*!
+ * \file ParallelParseBench.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * Scaling benchmark for json::parse_parallel, usage:
+ *   ParallelParseBench-release [records] [repeat]
+ */
+
+#include <json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+static std::string make_document(size_t records) {
+    std::ostringstream oss;
+    oss << "[";
+    for (size_t i = 0; i < records; ++i) {
+        oss << (i ? "," : "")
+            << "{\"id\":" << i
+            << ",\"name\":\"record number " << i << "\""
+            << ",\"score\":" << (i % 1000) / 10.0
+            << ",\"active\":" << (i % 2 ? "true" : "false")
+            << ",\"tags\":[\"alpha\",\"beta\",\"gamma\"]"
+            << ",\"owner\":{\"id\":" << i % 97 << ",\"email\":\"user" << i % 97 << "@example.com\"}}";
+    }
+    oss << "]";
+    return oss.str();
+}
+
+template <typename Function> static double measure(Function f, int repeat) {
+    double best = 0;
+    for (int r = 0; r < repeat; ++r) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        f();
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = (r == 0 || elapsed < best) ? elapsed : best;
+    }
+    return best;
+}
+
+int main(int argc, char *argv[]) {
+    size_t records = argc > 1 ? static_cast<size_t>(atol(argv[1])) : 500000;
+    int repeat = argc > 2 ? atoi(argv[2]) : 3;
+
+    std::string spec = make_document(records);
+    double megabytes = static_cast<double>(spec.size()) / (1024 * 1024);
+
+    std::cout << "Document: " << records << " records, "
+              << std::fixed << std::setprecision(1) << megabytes << " MB" << std::endl;
+
+    double base = measure([&]() { json::parse(spec); }, repeat);
+    std::cout << std::setw(10) << "threads" << std::setw(12) << "seconds"
+              << std::setw(12) << "MB/s" << std::setw(10) << "speedup" << std::endl;
+    std::cout << std::setw(10) << "parse" << std::setw(12) << std::setprecision(3) << base
+              << std::setw(12) << std::setprecision(1) << megabytes / base
+              << std::setw(10) << std::setprecision(2) << 1.0 << std::endl;
+
+    for (unsigned int threads = 1; threads <= 16; threads *= 2) {
+        double elapsed = measure([&]() { json::parse_parallel(spec, threads); }, repeat);
+        std::cout << std::setw(10) << threads << std::setw(12) << std::setprecision(3) << elapsed
+                  << std::setw(12) << std::setprecision(1) << megabytes / elapsed
+                  << std::setw(10) << std::setprecision(2) << base / elapsed << std::endl;
+    }
+
+    return 0;
+}
@@ -9,6 +9,14 @@
 #define JSON_HPP
 
 #include "json/value.hpp"
+#include "json/parser.hpp"
+#include "json/hash.hpp"
+#include "json/cbor.hpp"
+#include "json/frozen.hpp"
+#include "json/shared_document.hpp"
+#include "json/tape.hpp"
+#include "json/pointer_set.hpp"
+#include "json/patch.hpp"
 
 /**
  * @brief Nice alias to the actual JSON class
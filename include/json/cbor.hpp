@@ -0,0 +1,64 @@
+/*!
+ * \file cbor.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#ifndef JSON_CBOR_HPP
+#define JSON_CBOR_HPP
+
+#include "value.hpp"
+
+#include <vector>
+
+namespace json {
+
+/**
+ * @brief Encodes @p value as CBOR (RFC 8949).
+ *
+ * Arrays and maps have definite lengths and every argument takes as few bytes as
+ * possible (preferred serialization), doubles are written in single precision when no
+ * precision is lost.
+ *
+ * @return The encoded value
+ */
+std::vector<uint8_t> to_cbor(const Value& value);
+
+/**
+ * @brief Appends the CBOR encoding of @p value to @p out.
+ *
+ * Reusing the same buffer for many values saves growing a new one each time.
+ */
+void to_cbor(const Value& value, std::vector<uint8_t>& out);
+
+/**
+ * @brief Decodes the CBOR data item in @p data.
+ *
+ * Values are built as the text parser builds them, arrays are not packed (see
+ * @c Value::pack). Tags are skipped (the tagged item is decoded), byte strings
+ * are decoded as strings, and @c undefined as @c null.
+ *
+ * @param data The encoded data item
+ * @param size Size of the data, which must hold exactly one item
+ *
+ * @return The result JSON
+ *
+ * @exception parse_error When the data is not well-formed, or holds a map having keys
+ * other than strings, an integer out of the range of @c int64_t, a NaN or infinity, or a
+ * simple value that has no JSON counterpart.
+ */
+Value from_cbor(const uint8_t *data, size_t size);
+
+/**
+ * @brief Decodes the CBOR data item in @p data.
+ *
+ * @exception parse_error
+ *
+ * @see from_cbor(const uint8_t *, size_t)
+ */
+Value from_cbor(const std::vector<uint8_t>& data);
+
+} // namespace json
+
+#endif // JSON_CBOR_HPP
@@ -0,0 +1,60 @@
+/*!
+ * \file columns.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * json_object Version 2 - Arrays of objects stored by column
+ */
+
+#ifndef JSON_DETAIL_COLUMNS_HPP
+#define JSON_DETAIL_COLUMNS_HPP
+
+#include "../value.hpp"
+
+#include <string>
+#include <vector>
+
+namespace json {
+namespace detail {
+
+/**
+ * @brief The elements of an array of objects having the same keys, stored by column:
+ * one contiguous vector per key, typed when all the rows have the same scalar type.
+ */
+class columns {
+public:
+    struct column {
+        enum storage {
+            ints,    /* all integers */
+            dbls,    /* all doubles */
+            strings, /* all strings, row i is [offsets[i], offsets[i + 1]) within the pool */
+            values   /* anything else */
+        };
+
+        std::string          key;
+        storage              kind;
+        std::vector<int64_t> int_vals;
+        std::vector<double>  dbl_vals;
+        std::vector<size_t>  offsets;
+        std::string          pool;
+        std::vector<Value>   any_vals;
+
+        /* the value at row `row` */
+        Value at(size_t row) const;
+    };
+
+    size_t              rows;
+    std::vector<column> cols; /* sorted by key */
+
+    /* the column of `key`, nullptr if there is no such column */
+    const column *find(const std::string& key) const;
+
+    /* stores `array` by column, nullptr if the elements are not objects having the same keys */
+    static columns *build(const Value::array_type& array);
+};
+
+} // namespace detail
+} // namespace json
+
+#endif // JSON_DETAIL_COLUMNS_HPP
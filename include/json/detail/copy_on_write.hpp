@@ -0,0 +1,152 @@
+/*!
+ * \file copy_on_write.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * json_object Version 2 - Containers shared between copies
+ */
+
+#ifndef JSON_DETAIL_COPY_ON_WRITE_HPP
+#define JSON_DETAIL_COPY_ON_WRITE_HPP
+
+#include "compiler.hpp"
+#include "ref_count.hpp"
+
+namespace json {
+namespace detail {
+
+/**
+ * @brief A container of type @c T shared by all its copies until one of them is
+ * modified, which then gets a copy of its own (copy-on-write).
+ *
+ * Once a reference (or iterator) to the content has been handed out, that is after
+ * @c leak, the container is no longer shared: copies copy the content right away, so
+ * that writing through the reference is not seen by the copies.
+ *
+ * References obtained through the const accessors do not leak the content: @c write
+ * leaves them pointing into the content still shared by the other copies.
+ */
+template <typename T> class copy_on_write {
+public:
+    /* empty content, nothing allocated */
+    copy_on_write()
+        : block_(nullptr),
+          leaked_(false) {
+    }
+
+    explicit copy_on_write(const T& value)
+        : block_(new block(value)),
+          leaked_(false) {
+    }
+
+    copy_on_write(const copy_on_write& other)
+        : block_(other.share()),
+          leaked_(false) {
+    }
+
+    ~copy_on_write() {
+        release(block_);
+    }
+
+    copy_on_write& operator=(const copy_on_write& other) {
+        block *shared = other.share(); // `other` may be part of the content being released
+        release(block_);
+        block_ = shared;
+        leaked_ = false;
+        return *this;
+    }
+
+#if JSON_HAVE_CXX11
+    copy_on_write(copy_on_write&& other) noexcept
+        : block_(other.block_),
+          leaked_(other.leaked_) {
+        other.block_ = nullptr;
+        other.leaked_ = false;
+    }
+
+    copy_on_write& operator=(copy_on_write&& other) noexcept {
+        if (this != &other) {
+            block *moved = other.block_; // `other` may be part of the content being released
+            bool leaked = other.leaked_;
+            other.block_ = nullptr;
+            other.leaked_ = false;
+            release(block_);
+            block_ = moved;
+            leaked_ = leaked;
+        }
+        return *this;
+    }
+#endif
+
+    /* read-only access, never copies */
+    const T& operator*() const {
+        return block_ != nullptr ? block_->value : empty();
+    }
+
+    const T *operator->() const {
+        return &**this;
+    }
+
+    /* write access, copies the content if shared */
+    T& write() {
+        if (block_ == nullptr) {
+            block_ = new block();
+        } else if (!block_->refs.unique()) {
+            block *copy = new block(block_->value);
+            release(block_);
+            block_ = copy;
+        }
+        return block_->value;
+    }
+
+    /* write access for callers that keep references to the content */
+    T& leak() {
+        T& value = write();
+        leaked_ = true;
+        return value;
+    }
+
+private:
+    struct block {
+        ref_count refs;
+        T         value;
+
+        block() {
+        }
+
+        explicit block(const T& v)
+            : value(v) {
+        }
+    };
+
+    block *block_;
+    bool   leaked_;
+
+    static const T& empty() {
+        static const T value;
+        return value;
+    }
+
+    block *share() const {
+        if (block_ == nullptr) {
+            return nullptr;
+        }
+        if (leaked_) {
+            return new block(block_->value);
+        }
+        block_->refs.acquire();
+        return block_;
+    }
+
+    static void release(block *b) {
+        if (b != nullptr && b->refs.release()) {
+            delete b;
+        }
+    }
+};
+
+} // namespace detail
+} // namespace json
+
+#endif // JSON_DETAIL_COPY_ON_WRITE_HPP
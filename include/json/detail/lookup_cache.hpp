@@ -0,0 +1,130 @@
+/*!
+ * \file lookup_cache.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * json_object Version 2 - Indexes for <key>=<value> lookups and memoized hashes
+ */
+
+#ifndef JSON_DETAIL_LOOKUP_CACHE_HPP
+#define JSON_DETAIL_LOOKUP_CACHE_HPP
+
+#include "compiler.hpp"
+
+#include <map>
+#include <string>
+#if JSON_HAVE_CXX11
+#include <atomic>
+#include <unordered_map>
+#endif
+
+namespace json {
+
+class Value;
+
+namespace detail {
+
+/**
+ * @brief Indexes over the children of an object or array, by the value of one of
+ * their members, used by @c Pointer to resolve <key>=<value> tokens. Also keeps
+ * the hash of the container when memoized by @c json::hash.
+ *
+ * The cache belongs to a single container and is never copied along with it.
+ */
+class lookup_cache {
+public:
+    struct entry {
+        size_t       position; /* among the children, the first one wins */
+        const Value *value;
+    };
+
+#if JSON_HAVE_CXX11
+    typedef std::unordered_map<std::string, entry> index_type;
+#else
+    typedef std::map<std::string, entry>           index_type;
+#endif
+
+    lookup_cache()
+        : table_(nullptr),
+          hash_(0) {
+    }
+
+    lookup_cache(const lookup_cache&)
+        : table_(nullptr),
+          hash_(0) {
+    }
+
+    ~lookup_cache() {
+        clear();
+    }
+
+    lookup_cache& operator=(const lookup_cache&) {
+        clear();
+        return *this;
+    }
+
+#if JSON_HAVE_CXX11
+    /* the children move along, the indexes of the source would point to them */
+    lookup_cache(lookup_cache&& other)
+        : table_(nullptr),
+          hash_(0) {
+        other.clear();
+    }
+
+    lookup_cache& operator=(lookup_cache&& other) {
+        clear();
+        other.clear();
+        return *this;
+    }
+#endif
+
+    /* the index over the member `key` of the children, nullptr if not built */
+    const index_type *find(const std::string& key) const;
+
+    /* a new, empty index over the member `key` of the children */
+    index_type& create(const std::string& key);
+
+    /* the memoized hash, 0 if not computed */
+    uint64_t hash() const {
+#if JSON_HAVE_CXX11
+        return hash_.load(std::memory_order_relaxed);
+#else
+        return hash_;
+#endif
+    }
+
+    void hash(uint64_t value) const {
+#if JSON_HAVE_CXX11
+        hash_.store(value, std::memory_order_relaxed);
+#else
+        hash_ = value;
+#endif
+    }
+
+    /* drops all the indexes and the hash */
+    void clear() {
+        if (table_ != nullptr) {
+            destroy();
+        }
+        hash(0);
+    }
+
+private:
+    typedef std::map<std::string, index_type> table_type;
+
+    table_type *table_;
+
+#if JSON_HAVE_CXX11
+    mutable std::atomic<uint64_t> hash_; /* concurrent readers may memoize it */
+#else
+    mutable uint64_t              hash_;
+#endif
+
+    void destroy();
+};
+
+} // namespace detail
+} // namespace json
+
+#endif // JSON_DETAIL_LOOKUP_CACHE_HPP
@@ -0,0 +1,102 @@
+/*!
+ * \file raw_text.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * json_object Version 2 - Shared pieces of JSON text
+ */
+
+#ifndef JSON_DETAIL_RAW_TEXT_HPP
+#define JSON_DETAIL_RAW_TEXT_HPP
+
+#include "compiler.hpp"
+
+#include <vector>
+
+namespace json {
+namespace detail {
+
+class columns;
+
+/**
+ * @brief A piece of JSON text. All the pieces sliced from the same text share
+ * a single reference-counted buffer, so copies are cheap.
+ *
+ * The buffer may hold the elements of an array already decoded but stored compactly
+ * instead of text (see @c Value::is_packed).
+ */
+class raw_text {
+public:
+    /* what the buffer holds */
+    enum content {
+        json_text,
+        column_table,  /* objects having the same keys, see columns */
+        packed_int,    /* int64_t */
+        packed_double  /* double */
+    };
+
+    /* empty text, no buffer */
+    raw_text();
+
+    /* copies `size` bytes at `data` into a new buffer */
+    raw_text(const char *data, size_t size);
+
+    /* takes ownership of `table` */
+    explicit raw_text(columns *table);
+
+    /* takes over the numbers in `values`, which is left empty */
+    explicit raw_text(std::vector<int64_t>& values);
+    explicit raw_text(std::vector<double>& values);
+
+    raw_text(const raw_text& other);
+
+    ~raw_text();
+
+    raw_text& operator=(const raw_text& other);
+
+    /* a piece of this text, sharing the buffer */
+    raw_text slice(const char *begin, size_t size) const;
+
+    const char *data() const {
+        return static_cast<const char*>(data_);
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return buffer_ == nullptr;
+    }
+
+    /* json_text for empty texts */
+    content kind() const;
+
+    /* the table of a column_table buffer */
+    const columns& table() const;
+
+    /* the numbers of a packed_int (int64_t) or packed_double (double) buffer */
+    template <typename T> const T *values() const {
+        return static_cast<const T*>(data_);
+    }
+
+    /* number of numbers in a packed_int or packed_double buffer */
+    size_t count() const {
+        return size_;
+    }
+
+private:
+    struct buffer;
+
+    raw_text(buffer *buf, const char *data, size_t size);
+
+    buffer     *buffer_;
+    const void *data_; /* the text, or the vector of numbers of the buffer */
+    size_t      size_; /* of the text, or number of numbers */
+};
+
+} // namespace detail
+} // namespace json
+
+#endif // JSON_DETAIL_RAW_TEXT_HPP
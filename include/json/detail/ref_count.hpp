@@ -0,0 +1,72 @@
+/*!
+ * \file ref_count.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * json_object Version 2 - Thread-safe reference counter
+ */
+
+#ifndef JSON_DETAIL_REF_COUNT_HPP
+#define JSON_DETAIL_REF_COUNT_HPP
+
+#include "compiler.hpp"
+
+#if JSON_HAVE_CXX11
+#include <atomic>
+#endif
+
+namespace json {
+namespace detail {
+
+/**
+ * @brief Reference counter of objects shared between threads, starts at one.
+ */
+class ref_count {
+public:
+    ref_count()
+        : refs_(1) {
+    }
+
+    void acquire() {
+#if JSON_HAVE_CXX11
+        refs_.fetch_add(1, std::memory_order_relaxed);
+#else
+        __sync_add_and_fetch(&refs_, 1);
+#endif
+    }
+
+    /* whether this was the last reference */
+    bool release() {
+#if JSON_HAVE_CXX11
+        return refs_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+#else
+        return __sync_sub_and_fetch(&refs_, 1) == 0;
+#endif
+    }
+
+    /* whether there is a single reference, i.e. the caller's */
+    bool unique() const {
+#if JSON_HAVE_CXX11
+        return refs_.load(std::memory_order_acquire) == 1;
+#else
+        return __sync_add_and_fetch(const_cast<size_t*>(&refs_), 0) == 1;
+#endif
+    }
+
+private:
+    /* non-copyable */
+    ref_count(const ref_count&);
+    ref_count& operator=(const ref_count&);
+
+#if JSON_HAVE_CXX11
+    std::atomic<size_t> refs_;
+#else
+    size_t              refs_;
+#endif
+};
+
+} // namespace detail
+} // namespace json
+
+#endif // JSON_DETAIL_REF_COUNT_HPP
@@ -72,6 +72,24 @@ private:
     unsigned int column_;
 };
 
+/**
+ * @brief Thrown when a JSON Patch cannot be applied
+ */
+class patch_error: public error_base {
+public:
+    explicit patch_error(const std::string& msg);
+    virtual ~patch_error() noexcept;
+};
+
+/**
+ * @brief Thrown when a snapshot cannot be written, or read back intact
+ */
+class snapshot_error: public error_base {
+public:
+    explicit snapshot_error(const std::string& msg);
+    virtual ~snapshot_error() noexcept;
+};
+
 } // namespace json
 
 #endif // JSON_ERRORS_HPP
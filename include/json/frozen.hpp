@@ -0,0 +1,350 @@
+/*!
+ * \file frozen.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#ifndef JSON_FROZEN_HPP
+#define JSON_FROZEN_HPP
+
+#include "detail/compiler.hpp"
+#include "pointer.hpp"
+#include "type.hpp"
+
+#include <string>
+
+namespace json {
+
+class Value;
+class FrozenDocument;
+
+/**
+ * @brief A read-only JSON value within a @c FrozenDocument.
+ *
+ * Frozen values have no mutation paths at all: every member function is const and
+ * none of them changes any state, not even a cache, so any number of threads may read
+ * the same value concurrently without synchronization.
+ *
+ * The children of an object or array are stored contiguously (object members sorted by
+ * key), so they can be iterated with @c begin and @c end:
+ * @code
+ *   for (const json::FrozenValue *it = users.begin(); it != users.end(); ++it) {
+ *       std::cout << it->key() << ": " << (*it)["name"].to_string() << std::endl;
+ *   }
+ * @endcode
+ *
+ * @remarks Frozen values are owned by their document, references to them are valid as
+ * long as a copy of the document exists.
+ */
+class FrozenValue {
+public:
+    /**
+     * @return The type of this JSON. @see Type
+     */
+    Type::Value type() const;
+
+    bool is_null() const;
+    bool is_boolean() const;
+    bool is_integer() const;
+    bool is_double() const;
+    bool is_string() const;
+    bool is_array() const;
+    bool is_object() const;
+
+    /**
+     * @return @c true if this JSON is an empty object or an empty array.
+     */
+    bool empty() const;
+
+    /**
+     * @return The number of members or elements.
+     *
+     * @exception bad_json_type When called on values having type other than @c Object and @c Array.
+     */
+    size_t size() const;
+
+    /**
+     * @return The key of this value within its parent object, empty for the root and
+     * for array elements.
+     */
+    std::string key() const;
+
+    /**
+     * @return @c true if this JSON has type Object and contains the key @p key.
+     */
+    bool exists(const std::string& key) const;
+
+    /**
+     * @return The underlying boolean value.
+     *
+     * @exception bad_json_type When called on values having type other than @c Boolean.
+     */
+    bool to_bool() const;
+
+    /**
+     * @return The underlying integer value.
+     *
+     * @exception bad_json_type When called on values having type other than @c Integer.
+     */
+    int64_t to_int() const;
+
+    /**
+     * @return The underlying number, integers are converted.
+     *
+     * @exception bad_json_type When called on values having type other than @c Double or @c Integer.
+     */
+    double to_double() const;
+
+    /**
+     * @return A copy of the underlying string.
+     *
+     * @exception bad_json_type When called on values having type other than @c String.
+     */
+    std::string to_string() const;
+
+    /**
+     * @return The underlying string, null-terminated. Use @c to_string for strings having
+     * embedded null characters.
+     *
+     * @exception bad_json_type When called on values having type other than @c String.
+     */
+    const char *c_str() const;
+
+    /**
+     * @return The member having key @p key.
+     *
+     * @exception bad_json_type When called on values having type other than @c Object.
+     * @exception key_not_found When the key does not exist.
+     */
+    const FrozenValue& operator[](const std::string& key) const;
+
+    /**
+     * @return The element at position @p idx.
+     *
+     * @exception bad_json_type When called on values having type other than @c Array.
+     * @exception std::out_of_range When @p idx is out of bounds.
+     */
+    const FrozenValue& operator[](size_t idx) const;
+
+    /**
+     * @return The value identified by the JSON pointer @p pointer.
+     *
+     * @exception key_not_found When no value is found.
+     * @exception parse_error When a token is not a valid array index where one is expected.
+     */
+    const FrozenValue& operator[](const Pointer& pointer) const;
+
+    const FrozenValue& at(const std::string& key) const;
+    const FrozenValue& at(size_t idx) const;
+    const FrozenValue& at(const Pointer& pointer) const;
+
+    /**
+     * @return The member having key @p key, @c nullptr if this JSON is not an object or
+     * there is no such member.
+     */
+    const FrozenValue *find(const std::string& key) const;
+
+    /**
+     * @return The value identified by the JSON pointer @p pointer, @c nullptr if there is
+     * no such value.
+     *
+     * @exception parse_error When a token is not a valid array index where one is expected.
+     */
+    const FrozenValue *find(const Pointer& pointer) const;
+
+    /**
+     * @return The first member or element, members are sorted by key.
+     *
+     * @exception bad_json_type When called on values having type other than @c Object and @c Array.
+     */
+    const FrozenValue *begin() const;
+
+    /**
+     * @return Past the last member or element.
+     *
+     * @exception bad_json_type When called on values having type other than @c Object and @c Array.
+     */
+    const FrozenValue *end() const;
+
+    /**
+     * @return A (mutable) copy of this JSON.
+     */
+    Value thaw() const;
+
+    /**
+     * @brief Converts to JSON notation.
+     *
+     * @param pretty Causes the resulting string to be pretty-printed.
+     */
+    std::string stringify(bool pretty = false) const;
+
+private:
+    Type::Value type_;
+    uint32_t    key_size_;
+    const char *key_;      /* within the string pool (interned), members of objects only */
+    size_t      size_;     /* length of strings, number of children of objects and arrays */
+
+    union {
+        bool               bool_val;
+        int64_t            int_val;
+        double             dbl_val;
+        const char        *str_val;  /* within the string pool */
+        const FrozenValue *children; /* contiguous, members sorted by key */
+    } value_;
+
+    /* the nodes are made by FrozenDocument only */
+    FrozenValue();
+
+    /* where the member of the last object matched by a filter was found */
+    struct key_hint {
+        const char *key;   /* interned */
+        size_t      index;
+
+        key_hint()
+            : key(nullptr),
+              index(0) {
+        }
+    };
+
+    /* the child of `obj` identified by `tok`, nullptr if there is no such child */
+    static const FrozenValue *step(const FrozenValue *obj, const Pointer::token& tok);
+    /* checks if `obj` is an object having the <key>=<value> of the token */
+    static bool is_a_match(const FrozenValue& obj, const Pointer::token& tok, key_hint& hint);
+
+    friend class FrozenDocument;
+};
+
+/**
+ * @brief An immutable snapshot of a JSON value, compacted into a single array of nodes
+ * (in level order) and a single pool of strings.
+ *
+ * Keys are interned: each distinct key is stored once no matter how many objects have
+ * it, so large arrays of objects having the same schema take little more than the nodes.
+ *
+ * Copying a document is cheap: all the copies share the same snapshot, which is released
+ * along with the last copy. Documents (and their copies) can be read by any number of
+ * threads concurrently without synchronization.
+ */
+class FrozenDocument {
+public:
+    /**
+     * @brief Constructs a document holding @c null.
+     */
+    FrozenDocument();
+
+    /**
+     * @brief Takes a snapshot of @p value.
+     *
+     * @exception key_not_found When @p value has placeholders created by the
+     * non-const @c operator[] of @c Value.
+     */
+    explicit FrozenDocument(const Value& value);
+
+    FrozenDocument(const FrozenDocument& other);
+
+    ~FrozenDocument();
+
+    FrozenDocument& operator=(const FrozenDocument& other);
+
+    /**
+     * @return The root of the document.
+     */
+    const FrozenValue& root() const;
+
+    const FrozenValue& operator*() const;
+    const FrozenValue *operator->() const;
+
+    /**
+     * @return The number of values in the document.
+     */
+    size_t count() const;
+
+    /**
+     * @return The number of bytes taken by the document.
+     */
+    size_t memory() const;
+
+private:
+    struct tree;
+    tree *tree_;
+
+    /* takes over a reference to `t` */
+    explicit FrozenDocument(tree *t);
+
+    /* a new reference to the tree */
+    tree *share() const;
+
+    /* takes a new reference to `t` */
+    static tree *acquire(tree *t);
+
+    /* drops a reference to `t` */
+    static void release(tree *t);
+
+    static tree *build(const Value& value);
+
+    friend class SharedDocument; /* publishes the trees */
+};
+
+/**
+ * @brief Takes an immutable snapshot of @p value.
+ *
+ * @see FrozenDocument
+ */
+FrozenDocument freeze(const Value& value);
+
+/********************/
+/* inline functions */
+/********************/
+
+inline bool FrozenValue::is_null() const {
+    return type_ == Type::Null;
+}
+
+inline bool FrozenValue::is_boolean() const {
+    return type_ == Type::Boolean;
+}
+
+inline bool FrozenValue::is_integer() const {
+    return type_ == Type::Integer;
+}
+
+inline bool FrozenValue::is_double() const {
+    return type_ == Type::Double;
+}
+
+inline bool FrozenValue::is_string() const {
+    return type_ == Type::String;
+}
+
+inline bool FrozenValue::is_array() const {
+    return type_ == Type::Array;
+}
+
+inline bool FrozenValue::is_object() const {
+    return type_ == Type::Object;
+}
+
+inline const FrozenValue& FrozenValue::at(const std::string& key) const {
+    return (*this)[key];
+}
+
+inline const FrozenValue& FrozenValue::at(size_t idx) const {
+    return (*this)[idx];
+}
+
+inline const FrozenValue& FrozenValue::at(const Pointer& pointer) const {
+    return (*this)[pointer];
+}
+
+inline const FrozenValue& FrozenDocument::operator*() const {
+    return root();
+}
+
+inline const FrozenValue *FrozenDocument::operator->() const {
+    return &root();
+}
+
+} // namespace json
+
+#endif // JSON_FROZEN_HPP
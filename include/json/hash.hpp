@@ -0,0 +1,71 @@
+/*!
+ * \file hash.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#ifndef JSON_HASH_HPP
+#define JSON_HASH_HPP
+
+#include "value.hpp"
+
+#if JSON_HAVE_CXX11
+#include <functional>
+#endif
+
+namespace json {
+
+/**
+ * @brief Makes @c json::hash keep the hash of every object and array within the value.
+ */
+extern const struct json_spec_memoize{} option_memoize;
+
+/**
+ * @brief Structural 64-bit hash of @p value.
+ *
+ * The hash is consistent with deep equality: equal values have equal hashes, both for
+ * @c operator== and for @c Value::equals with no tolerance. Objects hash the same
+ * regardless of the order their members were inserted in, and numbers hash by their
+ * value, so @c 1 and @c 1.0 have the same hash.
+ *
+ * @exception key_not_found When @p value (or any of its children) is a placeholder
+ * created by the non-const @c operator[].
+ */
+uint64_t hash(const Value& value);
+
+/**
+ * @brief Structural 64-bit hash of @p value, memoizing the hash of its objects and arrays.
+ *
+ * Memoized hashes are dropped by the non-const accessors of the container, so after a
+ * small change only the containers along the path to it are hashed again.
+ *
+ * @code
+ *   uint64_t before = json::hash(doc, json::option_memoize);
+ *   doc["users"][1000]["name"] = "John"; // drops the hashes of doc, users and users[1000]
+ *   uint64_t after = json::hash(doc, json::option_memoize); // cheap
+ * @endcode
+ *
+ * @remarks Containers changed through a reference obtained earlier (i.e. without going
+ * through the accessors of their parents) leave stale hashes in their parents.
+ */
+uint64_t hash(const Value& value, const json_spec_memoize&);
+
+} // namespace json
+
+#if JSON_HAVE_CXX11
+namespace std {
+
+/**
+ * @brief Makes @c json::Value usable as key of unordered containers.
+ */
+template<> struct hash<json::Value> {
+    size_t operator()(const json::Value& value) const {
+        return static_cast<size_t>(json::hash(value));
+    }
+};
+
+} // namespace std
+#endif
+
+#endif // JSON_HASH_HPP
@@ -0,0 +1,81 @@
+/*!
+ * \file parser.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#ifndef JSON_PARSER_HPP
+#define JSON_PARSER_HPP
+
+#include <string>
+#include <istream>
+
+namespace json {
+
+class Value;
+
+/**
+ * @brief Reusable JSON parser.
+ *
+ * Each call to @c json::parse sets up (and tears down) a new parser, which allocates
+ * its state stack and token buffer. A @c Parser keeps them between documents, making
+ * it the right choice for parsing lots of small documents in a row.
+ *
+ * @remarks A @c Parser is not thread-safe, but it is fine to keep one per thread.
+ */
+class Parser {
+public:
+    /**
+     * @brief Constructs a new parser.
+     */
+    Parser();
+
+    ~Parser();
+
+    /**
+     * @brief Parses the character string @p spec.
+     *
+     * @param spec The character string to parse
+     * @param size Size of the character string
+     *
+     * @return The result JSON
+     *
+     * @exception parse_error
+     */
+    Value parse(const char *spec, size_t size);
+
+    /**
+     * @brief Parses the string @p spec.
+     *
+     * @param spec The string to parse
+     *
+     * @return The result JSON
+     *
+     * @exception parse_error
+     */
+    Value parse(const std::string& spec);
+
+    /**
+     * @brief Parses the content of the stream @p stream.
+     *
+     * @param stream The stream to read from
+     *
+     * @return The result JSON
+     *
+     * @exception parse_error
+     */
+    Value parse(std::istream& stream);
+
+private:
+    /* non-copyable */
+    Parser(const Parser&);
+    Parser& operator=(const Parser&);
+
+    class context;
+    context *context_;
+};
+
+} // namespace json
+
+#endif // JSON_PARSER_HPP
@@ -0,0 +1,105 @@
+/*!
+ * \file patch.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#ifndef JSON_PATCH_HPP
+#define JSON_PATCH_HPP
+
+#include "value.hpp"
+#include "pointer.hpp"
+
+#include <string>
+#include <vector>
+
+namespace json {
+
+/**
+ * @brief JSON Patch, a sequence of operations to apply to a JSON document.
+ * Implements RFC-6902 (https://tools.ietf.org/html/rfc6902)
+ *
+ * The paths are compiled once, when the patch is constructed, so the same patch can
+ * be applied to many documents.
+ *
+ * @remarks As defined by RFC-6901, the path "/" refers to the member having an empty key
+ * of the document, unlike @c Pointer("/") which refers to the whole document.
+ */
+class Patch {
+public:
+    /**
+     * @brief Constructs a patch from its JSON representation, an array of operations
+     * such as @c {"op":"add","path":"/a/b","value":1}.
+     *
+     * @param spec The JSON Patch document
+     *
+     * @exception parse_error If the patch document or any of its paths is invalid
+     */
+    explicit Patch(const Value& spec);
+
+    /**
+     * @brief Applies the operations, in order, to @p target.
+     *
+     * The operations are applied in place, @c move relinks the subtree instead of copying
+     * it. If one of them fails, the ones already applied are reverted and @p target is
+     * left unchanged. Reverting only needs the values replaced or removed along the way.
+     *
+     * @param target The JSON to patch
+     *
+     * @exception patch_error If an operation cannot be applied or a @c test fails
+     * @exception parse_error If a path is not valid within @p target
+     */
+    void apply(Value& target) const;
+
+    /**
+     * @return The number of operations in the patch
+     */
+    size_t size() const;
+
+private:
+    struct operation {
+        enum kind_type { add, remove, replace, move, copy, test };
+
+        kind_type   kind;
+        std::string path;        /* as written in the patch */
+        std::string parent_path; /* `path` without its last token */
+        std::string last;        /* last token of `path`, unescaped */
+        std::string from;
+        std::string from_parent;
+        std::string from_last;
+        Pointer     path_ptr;
+        Pointer     parent_ptr;
+        Pointer     from_ptr;
+        Pointer     from_parent_ptr;
+        Value       value;
+
+        operation(kind_type kind, const std::string& path, const std::string& from, const Value& value);
+    };
+
+    class context;
+
+    std::vector<operation> operations_;
+};
+
+/**
+ * @brief Computes a JSON Patch that turns @p from into @p to.
+ *
+ * Identical subtrees are skipped by comparing their hashes first. Arrays are aligned using
+ * their longest common subsequence, so inserting or removing elements does not touch the
+ * ones that follow. Very large arrays with scattered changes are compared by position.
+ *
+ * @remarks If the member having an empty key at the top level changes, the patch replaces
+ * the whole document, so that it reads the same to @c Pointer, for which "/" is the whole
+ * document.
+ *
+ * @param from The original JSON
+ * @param to The modified JSON
+ *
+ * @return The patch document, an array of operations suitable for @c Patch
+ */
+Value diff(const Value& from, const Value& to);
+
+} // namespace json
+
+#endif // JSON_PATCH_HPP
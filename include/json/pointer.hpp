@@ -8,6 +8,9 @@
 #ifndef JSON_POINTER_HPP
 #define JSON_POINTER_HPP
 
+#include "detail/compiler.hpp"
+#include "detail/lookup_cache.hpp"
+
 #include <string>
 #include <vector>
 
@@ -15,6 +18,21 @@ namespace json {
 
 class Value;
 
+/**
+ * @brief Makes a @c Pointer resolve its <key>=<value> tokens using an index.
+ *
+ * The index is built the first time a token is resolved against an array or object,
+ * with one entry per child (by the value of its member <key>), and is kept in the
+ * container so that later lookups, by any pointer constructed with this option, take
+ * constant time. It is dropped as soon as the container is accessed through a non-const
+ * member function.
+ *
+ * @remarks Building the index modifies the container, so the first lookup must not
+ * race with other readers. Children modified through references obtained before the
+ * index was built may be missed.
+ */
+extern const struct json_spec_index{} option_index;
+
 /**
  * @brief JSON pointer defines a string syntax for identifying a specific
  * value within a JSON document. Implements RFC-6901 (https://tools.ietf.org/html/rfc6901)
@@ -43,6 +61,16 @@ public:
      */
     explicit Pointer(const std::string& spec);
 
+    /**
+     * @brief Construct a new JSON pointer whose <key>=<value> tokens are resolved
+     * using an index. @see option_index
+     *
+     * @param spec String representation of the JSON pointer
+     *
+     * @exception parse_error If the spec is invalid
+     */
+    Pointer(const std::string& spec, const json_spec_index&);
+
     /**
      * @brief Looks for a nested JSON using the reference tokens
      * specified in this JSON pointer.
@@ -54,6 +82,58 @@ public:
      */
     const Value& get_reference(const Value& tgt) const;
 
+    /**
+     * @brief Looks for a nested JSON using the reference tokens
+     * specified in this JSON pointer, without throwing when it is missing.
+     *
+     * @param tgt The JSON on which to look
+     *
+     * @return A pointer to the JSON identified with the reference tokens
+     * defined by this JSON pointer, or @c nullptr if there is no such value.
+     *
+     * @exception parse_error If a token is not a valid array index where one is expected
+     */
+    const Value *find(const Value& tgt) const;
+
+    /**
+     * @brief Looks for a nested JSON using the reference tokens specified in this
+     * JSON pointer, creating the missing values.
+     *
+     * Missing object members are created as empty objects. Within arrays, the token
+     * @c - and the index right past the last element append a new element.
+     *
+     * @param tgt The JSON on which to look
+     *
+     * @return A reference to the (maybe new) JSON identified with the reference tokens.
+     *
+     * @exception parse_error If a token is not a valid array index where one is expected
+     * @exception bad_json_type If a value in the path is neither an object nor an array
+     * @exception std::out_of_range If an array index is past the end of the array
+     */
+    Value& get_or_create(Value& tgt) const;
+
+    /**
+     * @brief Like @c get_or_create, but within arrays a new element is always inserted
+     * at the position given by the last token, shifting the following elements
+     * (the "add" operation of RFC-6902).
+     *
+     * @param tgt The JSON on which to insert
+     *
+     * @return A reference to the new JSON, or to the existing object member
+     */
+    Value& insert_into(Value& tgt) const;
+
+    /**
+     * @brief Removes the JSON identified by this pointer.
+     *
+     * @param tgt The JSON from which to remove
+     *
+     * @return Whether a value was removed. The whole JSON (the empty pointer) is never removed.
+     *
+     * @exception parse_error If a token is not a valid array index where one is expected
+     */
+    bool erase_from(Value& tgt) const;
+
     /**
      * @brief Checks whether this JSON pointer is valid within the JSON
      * value specified as a parameter.
@@ -65,16 +145,54 @@ public:
     bool is_valid_for(const Value& tgt) const;
 
 private:
-    std::vector<std::string> tokens_;
+    /* a reference token, classified once when the pointer is built */
+    struct token {
+        std::string key;          /* the token itself, used as an object key */
+        std::string filter_key;   /* <key> of <key>=<value> tokens */
+        std::string filter_value; /* <value> of <key>=<value> tokens */
+        int64_t     filter_int;   /* <value> as an integer, valid if has_filter_int */
+        double      filter_dbl;   /* <value> as a real number, valid if has_filter_dbl */
+        size_t      index;        /* the token as an array index, valid if has_index */
+        bool        has_filter;
+        bool        has_filter_int;
+        bool        has_filter_dbl;
+        bool        has_index;
+        bool        bad_index;    /* '-' or leading '0'/'-', not allowed in arrays */
+        bool        use_index;    /* resolve <key>=<value> with the lookup index */
+
+        std::vector<std::string> index_keys; /* what <value> may match in the lookup index */
+
+        explicit token(const std::string& spec, bool use_index = false);
+    };
+
+    std::vector<token> tokens_;
+
+    friend class PointerSet; /* shares the tokens */
+    friend class FrozenValue; /* resolves the tokens on frozen documents */
+    friend class TapeValue; /* resolves the tokens on tapes */
 
+    /* resolves the tokens, on a miss returns nullptr with `parent` and `missing` set to where it stopped */
+    const Value *resolve(const Value& tgt,
+                         const Value * & parent,
+                         std::vector<token>::const_iterator& missing) const;
     /* escape characters as defined by the RFC */
-    void unescape(std::string& token);
+    static void unescape(std::string& token);
     /* splits the spec into reference tokens */
-    std::vector<std::string> make_tokens(const std::string& spec);
+    static std::vector<token> make_tokens(const std::string& spec, bool use_index);
     /* checks if the JSON obj contains key=value */
-    static bool is_a_match(const Value& obj, const std::string key, const std::string value);
-    /* looks for a child object matching the token */
-    static bool get_by_property_value(const Value * & obj, const std::string& token);
+    static bool is_a_match(const Value& obj, const token& tok);
+    /* the child of `obj` identified by `tok`, nullptr if there is no such child */
+    static const Value *step(const Value *obj, const token& tok);
+    /* walks all the tokens but the last one, creating the missing values */
+    Value& create_parent(Value& tgt) const;
+    /* the child of `obj` identified by `tok`, created if missing (inserted if `insert`) */
+    static Value& step_or_create(Value& obj, const token& tok, bool insert);
+    /* the key of the scalar `obj` in the lookup indexes, false for objects and arrays */
+    static bool index_key(const Value& obj, std::string& key);
+    /* indexes the children of `obj` by their member `key` */
+    static const detail::lookup_cache::index_type& build_index(const Value& obj, const std::string& key);
+    /* looks for a child object matching the <key>=<value> token */
+    static bool get_by_property_value(const Value * & obj, const token& tok);
 };
 
 } // namespace json
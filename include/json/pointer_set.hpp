@@ -0,0 +1,88 @@
+/*!
+ * \file pointer_set.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#ifndef JSON_POINTER_SET_HPP
+#define JSON_POINTER_SET_HPP
+
+#include "pointer.hpp"
+
+#include <string>
+#include <vector>
+
+namespace json {
+
+class Value;
+
+/**
+ * @brief A set of JSON pointers resolved together.
+ *
+ * The pointers are compiled into a prefix tree, so the tokens they have in common
+ * (i.e. @c /user in @c /user/id and @c /user/name) are resolved only once, in a single
+ * traversal of the document.
+ */
+class PointerSet {
+public:
+    /**
+     * @brief Constructs an empty set.
+     */
+    PointerSet();
+
+    /**
+     * @brief Constructs a set with all the pointers in @p pointers.
+     */
+    explicit PointerSet(const std::vector<Pointer>& pointers);
+
+    /**
+     * @brief Adds @p pointer to the set.
+     *
+     * @return The position of the pointer in the results of @c resolve.
+     */
+    size_t add(const Pointer& pointer);
+
+    /**
+     * @return The number of pointers in the set.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Resolves all the pointers within @p tgt.
+     *
+     * @param tgt The JSON on which to look
+     *
+     * @return The values identified by the pointers, in the order they were added,
+     * @c nullptr for those not found.
+     *
+     * @exception parse_error If a token is not a valid array index where one is expected
+     */
+    std::vector<const Value*> resolve(const Value& tgt) const;
+
+    /**
+     * @brief Resolves all the pointers within @p tgt into @p result, reusing its storage.
+     *
+     * @see resolve(const Value&) const
+     */
+    void resolve(const Value& tgt, std::vector<const Value*>& result) const;
+
+private:
+    /* a node of the prefix tree, nodes_[0] is the root */
+    struct node {
+        Pointer::token      tok;      /* the token leading to this node */
+        std::vector<size_t> children; /* positions in nodes_ */
+        std::vector<size_t> targets;  /* positions in the result of the pointers ending here */
+
+        explicit node(const Pointer::token& tok): tok(tok) {}
+    };
+
+    std::vector<node> nodes_;
+    size_t            count_;
+
+    void resolve(const node& current, const Value *obj, std::vector<const Value*>& result) const;
+};
+
+} // namespace json
+
+#endif // JSON_POINTER_SET_HPP
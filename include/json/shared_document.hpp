@@ -0,0 +1,88 @@
+/*!
+ * \file shared_document.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#ifndef JSON_SHARED_DOCUMENT_HPP
+#define JSON_SHARED_DOCUMENT_HPP
+
+#include "frozen.hpp"
+
+namespace json {
+
+class Value;
+
+/**
+ * @brief Holds the current version of a document that is read by many threads and
+ * replaced, as a whole, every now and then (i.e. a configuration reloaded while in use).
+ *
+ * Readers take a @c snapshot, a @c FrozenDocument they can keep using for as long as
+ * they need to, without taking any lock. Writers @c publish a new version, which the
+ * snapshots taken from then on see. Each version is released along with its last snapshot.
+ *
+ * @code
+ *   json::SharedDocument routes(json::parse_file("routes.json"));
+ *
+ *   // readers
+ *   json::FrozenDocument current = routes.snapshot();
+ *   lookup(current->at(json::Pointer("/routes/id=42")));
+ *
+ *   // writer
+ *   routes.publish(json::parse_file("routes.json"));
+ * @endcode
+ */
+class SharedDocument {
+public:
+    /**
+     * @brief Constructs a holder for a @c null document.
+     */
+    SharedDocument();
+
+    /**
+     * @brief Constructs a holder for @p doc.
+     */
+    explicit SharedDocument(const FrozenDocument& doc);
+
+    /**
+     * @brief Constructs a holder for a snapshot of @p value.
+     */
+    explicit SharedDocument(const Value& value);
+
+    ~SharedDocument();
+
+    /**
+     * @return The current version of the document.
+     *
+     * @remarks Lock-free, it never waits for writers.
+     */
+    FrozenDocument snapshot() const;
+
+    /**
+     * @brief Replaces the current version with @p doc.
+     *
+     * @remarks Concurrent writers are serialized. A writer waits for the readers that are
+     * taking a snapshot at the same time, but not for the snapshots already taken.
+     */
+    void publish(const FrozenDocument& doc);
+
+    /**
+     * @brief Replaces the current version with a snapshot of @p value.
+     *
+     * @see publish(const FrozenDocument&)
+     */
+    void publish(const Value& value);
+
+private:
+    /* non-copyable */
+    SharedDocument(const SharedDocument&);
+    SharedDocument& operator=(const SharedDocument&);
+
+    struct state;
+    state *state_;
+};
+
+} // namespace json
+
+#endif // JSON_SHARED_DOCUMENT_HPP
@@ -0,0 +1,68 @@
+/*!
+ * \file span.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#ifndef JSON_SPAN_HPP
+#define JSON_SPAN_HPP
+
+#include "detail/compiler.hpp"
+
+#include <cstddef>
+
+namespace json {
+
+/**
+ * @brief A view of @c size contiguous elements of type @c T owned by someone else
+ * (like C++20's std::span).
+ */
+template <typename T> class span {
+public:
+    typedef T        element_type;
+    typedef T*       iterator;
+    typedef T&       reference;
+
+    span()
+        : data_(nullptr),
+          size_(0) {
+    }
+
+    span(T *data, size_t size)
+        : data_(data),
+          size_(size) {
+    }
+
+    T *data() const {
+        return data_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    T *begin() const {
+        return data_;
+    }
+
+    T *end() const {
+        return data_ + size_;
+    }
+
+    T& operator[](size_t idx) const {
+        return data_[idx];
+    }
+
+private:
+    T     *data_;
+    size_t size_;
+};
+
+} // namespace json
+
+#endif // JSON_SPAN_HPP
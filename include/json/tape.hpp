@@ -0,0 +1,461 @@
+/*!
+ * \file tape.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#ifndef JSON_TAPE_HPP
+#define JSON_TAPE_HPP
+
+#include "detail/compiler.hpp"
+#include "pointer.hpp"
+#include "type.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+
+namespace json {
+
+class Value;
+class TapeDocument;
+
+/**
+ * @brief A read-only handle to a JSON value within a @c TapeDocument.
+ *
+ * Handles are small and meant to be passed by value. Objects and arrays know where
+ * they end, so stepping over one of them takes constant time no matter how big it is:
+ * @code
+ *   for (json::TapeValue::const_iterator it = users.begin(); it != users.end(); ++it) {
+ *       std::cout << it->key() << ": " << (*it)["name"].to_string() << std::endl;
+ *   }
+ * @endcode
+ *
+ * @remarks Members are kept in document order and are looked up by scanning them. If an
+ * object has a key more than once, the last member having it is found (and thawed), as
+ * @c json::parse keeps it; iterators and @c size still see all of them.
+ *
+ * @remarks Handles point into their document, they are valid as long as a copy of the
+ * document exists.
+ */
+class TapeValue {
+public:
+    class const_iterator;
+
+    /**
+     * @brief Constructs an invalid handle, as returned by @c find on a miss.
+     */
+    TapeValue();
+
+    /**
+     * @return @c false if this handle refers to no value.
+     */
+    bool valid() const;
+
+    /**
+     * @return The type of this JSON. @see Type
+     */
+    Type::Value type() const;
+
+    bool is_null() const;
+    bool is_boolean() const;
+    bool is_integer() const;
+    bool is_double() const;
+    bool is_string() const;
+    bool is_array() const;
+    bool is_object() const;
+
+    /**
+     * @return @c true if this JSON is an empty object or an empty array.
+     */
+    bool empty() const;
+
+    /**
+     * @return The number of members or elements.
+     *
+     * @exception bad_json_type When called on values having type other than @c Object and @c Array.
+     */
+    size_t size() const;
+
+    /**
+     * @return The key of this value within its parent object, empty for the root and
+     * for array elements.
+     */
+    std::string key() const;
+
+    /**
+     * @return @c true if this JSON has type Object and contains the key @p key.
+     */
+    bool exists(const std::string& key) const;
+
+    /**
+     * @return The underlying boolean value.
+     *
+     * @exception bad_json_type When called on values having type other than @c Boolean.
+     */
+    bool to_bool() const;
+
+    /**
+     * @return The underlying integer value.
+     *
+     * @exception bad_json_type When called on values having type other than @c Integer.
+     */
+    int64_t to_int() const;
+
+    /**
+     * @return The underlying number, integers are converted.
+     *
+     * @exception bad_json_type When called on values having type other than @c Double or @c Integer.
+     */
+    double to_double() const;
+
+    /**
+     * @return A copy of the underlying string.
+     *
+     * @exception bad_json_type When called on values having type other than @c String.
+     */
+    std::string to_string() const;
+
+    /**
+     * @return The underlying string, null-terminated. Use @c to_string for strings having
+     * embedded null characters.
+     *
+     * @exception bad_json_type When called on values having type other than @c String.
+     */
+    const char *c_str() const;
+
+    /**
+     * @return The member having key @p key.
+     *
+     * @exception bad_json_type When called on values having type other than @c Object.
+     * @exception key_not_found When the key does not exist.
+     */
+    TapeValue operator[](const std::string& key) const;
+
+    /**
+     * @return The element at position @p idx, found in @c O(idx) steps.
+     *
+     * @exception bad_json_type When called on values having type other than @c Array.
+     * @exception std::out_of_range When @p idx is out of bounds.
+     */
+    TapeValue operator[](size_t idx) const;
+
+    /**
+     * @return The value identified by the JSON pointer @p pointer.
+     *
+     * @exception key_not_found When no value is found.
+     * @exception parse_error When a token is not a valid array index where one is expected.
+     */
+    TapeValue operator[](const Pointer& pointer) const;
+
+    TapeValue at(const std::string& key) const;
+    TapeValue at(size_t idx) const;
+    TapeValue at(const Pointer& pointer) const;
+
+    /**
+     * @return The member having key @p key, an invalid handle if this JSON is not an
+     * object or there is no such member.
+     */
+    TapeValue find(const std::string& key) const;
+
+    /**
+     * @return The value identified by the JSON pointer @p pointer, an invalid handle if
+     * there is no such value.
+     *
+     * @exception parse_error When a token is not a valid array index where one is expected.
+     */
+    TapeValue find(const Pointer& pointer) const;
+
+    /**
+     * @return The first member or element, in document order.
+     *
+     * @exception bad_json_type When called on values having type other than @c Object and @c Array.
+     */
+    const_iterator begin() const;
+
+    /**
+     * @return Past the last member or element.
+     *
+     * @exception bad_json_type When called on values having type other than @c Object and @c Array.
+     */
+    const_iterator end() const;
+
+    /**
+     * @return A (mutable) copy of this JSON.
+     */
+    Value thaw() const;
+
+    /**
+     * @brief Converts to JSON notation.
+     *
+     * @param pretty Causes the resulting string to be pretty-printed.
+     */
+    std::string stringify(bool pretty = false) const;
+
+private:
+    const uint64_t *word_;    /* the first word of the value */
+    const uint64_t *key_;     /* the word of the key, members of objects only */
+    const char     *strings_; /* the string buffer of the document */
+
+    TapeValue(const uint64_t *word, const uint64_t *key, const char *strings);
+
+    /* the word past the value, where its next sibling starts */
+    const uint64_t *next() const;
+
+    /* the child of `obj` identified by `tok`, invalid if there is no such child */
+    static TapeValue step(const TapeValue& obj, const Pointer::token& tok);
+    /* checks if `obj` is an object having the <key>=<value> of the token */
+    static bool is_a_match(const TapeValue& obj, const Pointer::token& tok);
+
+    friend class TapeDocument;
+};
+
+/**
+ * @brief Forward iterator over the members or elements of a @c TapeValue.
+ */
+class TapeValue::const_iterator {
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef TapeValue                 value_type;
+    typedef ptrdiff_t                 difference_type;
+    typedef const TapeValue*          pointer;
+    typedef const TapeValue&          reference;
+
+    const_iterator();
+
+    reference operator*() const;
+    pointer operator->() const;
+
+    /* steps over the current value in constant time */
+    const_iterator& operator++();
+    const_iterator operator++(int);
+
+    bool operator==(const const_iterator& other) const;
+    bool operator!=(const const_iterator& other) const;
+
+private:
+    const uint64_t *pos_;    /* the word of the current member (its key) or element */
+    bool            object_; /* values are preceded by their keys */
+    TapeValue       current_;
+
+    const_iterator(const uint64_t *pos, bool object, const char *strings);
+
+    /* points `current_` at the value at `pos_` */
+    void load();
+
+    friend class TapeValue;
+};
+
+/**
+ * @brief An immutable JSON document stored as a flat tape of 64-bit words, produced by
+ * the parser directly, without building a tree of @c Value first.
+ *
+ * Scalars are stored inline (integers and doubles take a second word), strings and keys
+ * are offsets into a separate string buffer, and each object or array starts with a word
+ * holding the distance to its end, so skipping it takes constant time. The whole
+ * document takes two allocations: the tape and the string buffer. Nothing in them
+ * depends on where they are, so documents can be saved and then read in place from
+ * the file (see @c save_snapshot and @c open_snapshot).
+ *
+ * Copying a document is cheap: all the copies share the same tape, which is released
+ * along with the last copy. Documents (and their copies) can be read by any number of
+ * threads concurrently without synchronization.
+ */
+class TapeDocument {
+public:
+    /**
+     * @brief Constructs a document holding @c null.
+     */
+    TapeDocument();
+
+    /**
+     * @brief Writes @p value into a new tape.
+     *
+     * @exception key_not_found When @p value has placeholders created by the
+     * non-const @c operator[] of @c Value.
+     */
+    explicit TapeDocument(const Value& value);
+
+    TapeDocument(const TapeDocument& other);
+
+    ~TapeDocument();
+
+    TapeDocument& operator=(const TapeDocument& other);
+
+    /**
+     * @return The root of the document.
+     */
+    const TapeValue& root() const;
+
+    const TapeValue& operator*() const;
+    const TapeValue *operator->() const;
+
+    /**
+     * @return The number of words in the tape.
+     */
+    size_t count() const;
+
+    /**
+     * @return The number of bytes taken by the document.
+     */
+    size_t memory() const;
+
+private:
+    struct tape;
+    tape     *tape_;
+    TapeValue root_;
+
+    /* takes over a reference to `t` */
+    explicit TapeDocument(tape *t);
+
+    friend TapeDocument parse_tape(const char *spec, size_t size);
+    friend void save_snapshot(const TapeDocument& document, const std::string& path);
+    friend TapeDocument open_snapshot(const std::string& path, bool verify);
+};
+
+/**
+ * @brief Parses the character string @p spec into a tape.
+ *
+ * @param spec The character string to parse
+ * @param size Size of the character string
+ *
+ * @return The result document
+ *
+ * @exception parse_error
+ *
+ * @see TapeDocument
+ */
+TapeDocument parse_tape(const char *spec, size_t size);
+
+/**
+ * @brief Parses the string @p spec into a tape.
+ *
+ * @exception parse_error
+ *
+ * @see TapeDocument
+ */
+TapeDocument parse_tape(const std::string& spec);
+
+/**
+ * @brief Writes the tape of @p document into the file at @p path, which is replaced
+ * as a whole (the snapshot is written aside and then renamed).
+ *
+ * Snapshots are meant to be read back by @c open_snapshot on machines having the same
+ * byte order.
+ *
+ * @exception snapshot_error When the file cannot be written.
+ */
+void save_snapshot(const TapeDocument& document, const std::string& path);
+
+/**
+ * @brief Writes @p value as a tape into the file at @p path.
+ *
+ * @exception snapshot_error When the file cannot be written.
+ * @exception key_not_found When @p value has placeholders.
+ *
+ * @see save_snapshot(const TapeDocument&, const std::string&)
+ */
+void save_snapshot(const Value& value, const std::string& path);
+
+/**
+ * @brief Opens the snapshot written into the file at @p path.
+ *
+ * The file is mapped into memory and read in place: there is nothing to parse and
+ * nothing to copy, pages are loaded as they are read. The document keeps the file
+ * mapped until its last copy is released.
+ *
+ * @param path The snapshot file
+ * @param verify Causes the checksum of the whole file to be verified, which reads it
+ * all. The header is checked anyway.
+ *
+ * @exception snapshot_error When the file cannot be opened, is not a snapshot, was
+ * written by an incompatible version or machine, or is corrupted.
+ */
+TapeDocument open_snapshot(const std::string& path, bool verify = true);
+
+/********************/
+/* inline functions */
+/********************/
+
+inline bool TapeValue::valid() const {
+    return word_ != nullptr;
+}
+
+inline bool TapeValue::is_null() const {
+    return type() == Type::Null;
+}
+
+inline bool TapeValue::is_boolean() const {
+    return type() == Type::Boolean;
+}
+
+inline bool TapeValue::is_integer() const {
+    return type() == Type::Integer;
+}
+
+inline bool TapeValue::is_double() const {
+    return type() == Type::Double;
+}
+
+inline bool TapeValue::is_string() const {
+    return type() == Type::String;
+}
+
+inline bool TapeValue::is_array() const {
+    return type() == Type::Array;
+}
+
+inline bool TapeValue::is_object() const {
+    return type() == Type::Object;
+}
+
+inline TapeValue TapeValue::at(const std::string& key) const {
+    return (*this)[key];
+}
+
+inline TapeValue TapeValue::at(size_t idx) const {
+    return (*this)[idx];
+}
+
+inline TapeValue TapeValue::at(const Pointer& pointer) const {
+    return (*this)[pointer];
+}
+
+inline TapeValue::const_iterator::reference TapeValue::const_iterator::operator*() const {
+    return current_;
+}
+
+inline TapeValue::const_iterator::pointer TapeValue::const_iterator::operator->() const {
+    return &current_;
+}
+
+inline TapeValue::const_iterator TapeValue::const_iterator::operator++(int) {
+    const_iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+inline bool TapeValue::const_iterator::operator==(const const_iterator& other) const {
+    return pos_ == other.pos_;
+}
+
+inline bool TapeValue::const_iterator::operator!=(const const_iterator& other) const {
+    return !(*this == other);
+}
+
+inline const TapeValue& TapeDocument::root() const {
+    return root_;
+}
+
+inline const TapeValue& TapeDocument::operator*() const {
+    return root_;
+}
+
+inline const TapeValue *TapeDocument::operator->() const {
+    return &root_;
+}
+
+} // namespace json
+
+#endif // JSON_TAPE_HPP
@@ -11,8 +11,12 @@
 #define JSON_VALUE_HPP
 
 #include "detail/compiler.hpp"
+#include "detail/copy_on_write.hpp"
+#include "detail/lookup_cache.hpp"
+#include "detail/raw_text.hpp"
 #include "pointer.hpp"
 #include "errors.hpp"
+#include "span.hpp"
 #include "type.hpp"
 
 #include <map>
@@ -22,6 +26,7 @@ namespace json {
 
 namespace detail {
     class IO; // parser/writer
+    class hasher; // json::hash
 }
 
 /**
@@ -35,8 +40,23 @@ extern const struct json_spec_parse{} option_parse;
   */
 extern const struct json_spec_force{} option_force;
 
+/**
+ * @brief Makes the parser store the large arrays packed (see @c Value::is_packed).
+ */
+extern const struct json_spec_pack{} option_pack;
+
 /**
  * @brief A JSON value
+ *
+ * Copies share their objects and arrays until one of them is modified through the
+ * non-const accessors, which copy the objects and arrays along the path to the change.
+ *
+ * @remarks Modifying a value through the non-const accessors invalidates the references and
+ * iterators obtained before through its const accessors: the objects and arrays they point
+ * into may be shared with a copy, in which case the value gets copies of them and the
+ * references are left pointing into the content of the copy, which may be destroyed later.
+ * Obtain them again after the change. References obtained from a value that is not modified
+ * (e.g. the original of a modified copy) stay valid as long as it exists.
  */
 class Value {
 public:
@@ -137,6 +157,30 @@ public:
      */
     explicit Value(std::istream& stream);
 
+    /**
+     * @brief Constructs a copy of @p other, sharing its objects and arrays.
+     */
+    Value(const Value& other);
+
+    /**
+     * @brief Replaces the content of this JSON with a copy of @p other, which may be part
+     * of this JSON (i.e. @c doc = doc["data"]).
+     */
+    Value& operator=(const Value& other);
+
+#if JSON_HAVE_CXX11
+    /**
+     * @brief Constructs a JSON by taking the content of @p other.
+     */
+    Value(Value&& other) noexcept;
+
+    /**
+     * @brief Replaces the content of this JSON with the content of @p other, which may be
+     * part of this JSON.
+     */
+    Value& operator=(Value&& other);
+#endif
+
 #if JSON_HAVE_CXX11
     /**
      * Constructs a JSON object with type @c Object and having the elements
@@ -207,6 +251,27 @@ public:
      */
     bool is_object() const;
 
+    /**
+     * @return @c true if this JSON is an @c Object or @c Array still kept as JSON text,
+     * i.e. it has not been decoded yet. Raw values are written verbatim by @c stringify.
+     *
+     * @see parse_lazy, parse(const std::string&, const std::vector<Pointer>&)
+     */
+    bool is_raw() const;
+
+    /**
+     * @return @c true if this JSON is an @c Array stored packed: numbers in a contiguous buffer
+     * of @c int64_t or @c double, objects having the same keys by column, one contiguous vector
+     * per key. The elements are created on demand,
+     * when a reference to one of them (or an iterator) is requested or the array is modified.
+     * As with lazy values, even const accessors create them, use a @c FrozenDocument to share
+     * the array between threads. Arrays are only packed on request: by @c pack, or by the
+     * parser given @c option_pack.
+     *
+     * @see pack, to_int_span, to_double_span, to_int_column, to_double_column
+     */
+    bool is_packed() const;
+
     /**
      * @return @c true if one of the following conditions is met:
      *
@@ -295,6 +360,48 @@ public:
      */
     const map_type& to_map() const;
 
+    /**
+     * @return The member @p key of every element of an array packed by column (see
+     * @c is_packed), when all of them are integers. No copies.
+     *
+     * @exception bad_json_type When called on objects other than arrays packed by column, or
+     * the members are not all integers.
+     * @exception key_not_found When the elements do not have the member @p key.
+     *
+     * @remarks The span is valid while the array stays packed.
+     */
+    span<const int64_t> to_int_column(const key_type& key) const;
+
+    /**
+     * @return The elements of an array of integers stored packed (see @c is_packed). No copies.
+     *
+     * @exception bad_json_type When called on objects other than packed arrays of integers.
+     *
+     * @remarks The span is valid while the array stays packed.
+     */
+    span<const int64_t> to_int_span() const;
+
+    /**
+     * @return The elements of an array of doubles stored packed (see @c is_packed). No copies.
+     *
+     * @exception bad_json_type When called on objects other than packed arrays of doubles.
+     *
+     * @remarks The span is valid while the array stays packed.
+     */
+    span<const double> to_double_span() const;
+
+    /**
+     * @return The member @p key of every element of an array packed by column (see
+     * @c is_packed), when all of them are doubles. No copies.
+     *
+     * @exception bad_json_type When called on objects other than arrays packed by column, or
+     * the members are not all doubles.
+     * @exception key_not_found When the elements do not have the member @p key.
+     *
+     * @remarks The span is valid while the array stays packed.
+     */
+    span<const double> to_double_column(const key_type& key) const;
+
     /**
      * @return An iterator referring to the first element in the container.
      *
@@ -350,6 +457,41 @@ public:
      */
     void erase(const key_type& key);
 
+    /**
+     * @brief Removes the value identified by the JSON pointer @p pointer.
+     *
+     * @return Whether a value was removed.
+     *
+     * @exception parse_error When a token is not a valid array index where one is expected.
+     *
+     * @see Pointer::erase_from
+     */
+    bool erase(const Pointer& pointer);
+
+    /**
+     * @brief Applies the JSON Merge Patch @p patch, as defined in RFC-7386
+     * (https://tools.ietf.org/html/rfc7386).
+     *
+     * Members of @p patch replace the ones of this JSON, objects are merged recursively
+     * and @c null members remove the corresponding member. A patch other than an object
+     * replaces this JSON altogether.
+     *
+     * @return *this
+     *
+     * @remarks @p patch must not be part of this JSON.
+     */
+    Value& merge_patch(const Value& patch);
+
+#if JSON_HAVE_CXX11
+    /**
+     * @brief Applies the JSON Merge Patch @p patch, moving its members into this JSON
+     * instead of copying them.
+     *
+     * @see merge_patch(const Value&)
+     */
+    Value& merge_patch(Value&& patch);
+#endif
+
     /**
      * @return An iterator referring to the first element in the array.
      *
@@ -408,6 +550,19 @@ public:
      */
     void append(const_array_iterator ibegin, const_array_iterator iend);
 
+    /**
+     * @brief Stores the elements of this JSON Array packed, if all of them are integers, all
+     * of them are doubles, or all of them are objects having the same keys (stored by column).
+     * The parser packs such arrays when they are large enough if given @c option_pack.
+     *
+     * @return @c true if the array is packed.
+     *
+     * @remarks References to the elements are no longer valid if the array is packed.
+     *
+     * @see is_packed
+     */
+    bool pack();
+
     /**
      * @brief Searchs for a value using the JSON Pointer standard as defined in RFC-6901.
      *
@@ -432,6 +587,72 @@ public:
      */
     const Value& at(const Pointer& pointer) const;
 
+    /**
+     * @brief Searchs for a value using the JSON Pointer standard as defined in RFC-6901,
+     * without throwing when the value does not exist.
+     *
+     * @return A pointer to the value identified by the JSON Pointer argument, or
+     * @c nullptr if there is no such value.
+     *
+     * @param pointer A JSON Pointer object
+     *
+     * @exception parse_error When a token is not a valid array index where one is expected.
+     */
+    const Value *find(const Pointer& pointer) const;
+
+    /**
+     * @see find(const Pointer&) const
+     */
+    Value *find(const Pointer& pointer);
+
+    /**
+     * @brief Searchs for a value using the JSON Pointer standard as defined in RFC-6901,
+     * creating the missing values along the path.
+     *
+     * @return A reference to the value identified by the JSON Pointer argument.
+     *
+     * @param pointer A JSON Pointer object
+     *
+     * @exception parse_error When a token is not a valid array index where one is expected.
+     * @exception bad_json_type When a value in the path is neither an @c Object nor an @c Array.
+     * @exception std::out_of_range When an array index is past the end of the array.
+     *
+     * @see Pointer::get_or_create
+     */
+    Value& at_or_create(const Pointer& pointer);
+
+    /**
+     * @brief Sets the value identified by the JSON pointer @p pointer to @p val, creating
+     * the missing values along the path. The token @c - appends to an array.
+     *
+     * @return A reference to the new value.
+     *
+     * @see at_or_create
+     */
+    Value& set(const Pointer& pointer, const Value& val);
+
+    /**
+     * @brief Inserts @p val at the location identified by the JSON pointer @p pointer,
+     * shifting the following elements when the location is within an array (RFC-6902 "add").
+     *
+     * @return A reference to the new value.
+     *
+     * @see Pointer::insert_into
+     */
+    Value& insert(const Pointer& pointer, const Value& val);
+
+#if JSON_HAVE_CXX11
+    /**
+     * @see set(const Pointer&, const Value&)
+     */
+    Value& set(const Pointer& pointer, Value&& val);
+
+    /**
+     * @see insert(const Pointer&, const Value&)
+     */
+    Value& insert(const Pointer& pointer, Value&& val);
+#endif
+
     /**
      * @brief Optional get of an inner value of type T, returns a pre-defined default value
      * if the child does not exist. Supported values for T are:
@@ -452,9 +673,10 @@ public:
     template<typename T> T get_optional(const key_type& key, const T &default_value = T()) const;
 
     /**
-     * @brief Equality operator
+     * @brief Equality operator, objects and arrays are compared element by element.
      *
-     * @remarks Floating point number equality is not guaranteed, use with caution
+     * @remarks Values of different types are never equal (i.e. @c 1 and @c 1.0).
+     * Floating point number equality is not guaranteed, use with caution
      */
     bool operator==(const Value& other) const;
 
@@ -463,6 +685,34 @@ public:
      */
     bool operator!=(const Value& other) const;
 
+    /**
+     * @brief Deep equality where numbers are equal when they differ by at most @p epsilon,
+     * regardless of their type (@c Integer or @c Double).
+     *
+     * @param other The JSON to compare with
+     * @param epsilon The tolerance for numbers
+     */
+    bool equals(const Value& other, double epsilon) const;
+
+    /**
+     * @brief Total ordering of JSON values. Values of different types are ordered by their type,
+     * arrays and objects are compared lexicographically (objects by their key/value pairs).
+     *
+     * @return A negative number, zero, or a positive number when this JSON is less than, equal
+     * to, or greater than @p other.
+     */
+    int compare(const Value& other) const;
+
+    /**
+     * @brief Less than operator, makes @c Value usable as key of sorted containers.
+     *
+     * @see compare
+     */
+    bool operator<(const Value& other) const;
+    bool operator<=(const Value& other) const;
+    bool operator>(const Value& other) const;
+    bool operator>=(const Value& other) const;
+
     /**
      * Converts to JSON notation.
      *
@@ -524,37 +774,57 @@ private:
     /* constructor for invalid object */
     Value(const json_spec_private&, const std::string&);
 
+    /*
+     * Scalars share their storage. The string doubles as the key of placeholders, which
+     * are objects. Containers are shared by copies of this JSON until modified.
+     */
     struct Union {
-        bool         bool_val;
-        int64_t      int_val;
-        double       dbl_val;
-        std::string  str_val;
-        array_type   arr_val;
-        map_type     map_val;
-
-        Union(){}
+        union {
+            bool                             bool_val;
+            int64_t                          int_val;
+            double                           dbl_val;
+        };
+        std::string                          str_val;
+        detail::copy_on_write<array_type>    arr_val;
+        detail::copy_on_write<map_type>      map_val;
+
+        Union(): int_val(0){}
         Union(bool v): bool_val(v){}
         Union(int64_t v): int_val(v){}
         Union(double v): dbl_val(v){}
-        Union(const char* v): str_val(v){}
-        Union(const std::string& v): str_val(v){}
-        Union(const array_type& v): arr_val(v){}
-        Union(const map_type& v): map_val(v){}
+        Union(const char* v): int_val(0), str_val(v){}
+        Union(const std::string& v): int_val(0), str_val(v){}
+        Union(const array_type& v): int_val(0), arr_val(v){}
+        Union(const map_type& v): int_val(0), map_val(v){}
     };
 
+    /* placeholders created by the non-const operator[], the key is in value_.str_val */
     struct Temporary_Flag {
         bool is_temporary;
-        std::string temporary_key;
         Temporary_Flag(): is_temporary(false){}
-        Temporary_Flag(const std::string& s): is_temporary(true), temporary_key(s){}
+        explicit Temporary_Flag(bool b): is_temporary(b){}
     };
 
-    Type::Value    type_;
-    Union          value_;
-    Temporary_Flag temp_flag_;
+    Type::Value      type_;
+    Temporary_Flag   temp_flag_; /* packed next to the type */
+    Union            value_;
+    detail::raw_text raw_; /* text of objects and arrays not decoded yet, or packed arrays */
+
+    mutable detail::lookup_cache lookups_; /* <key>=<value> indexes (see option_index) and hash */
+
+    /* takes the content of `other`, which is not part of this JSON */
+    void assign(Value& other);
+
+    /* the placeholder becomes an actual member */
+    void fill_placeholder();
+
+    /* decodes the children of a lazily parsed object or array */
+    void expand() const;
+    void expand_lazy() const;
 
     friend class detail::IO; /* parser and printer */
     friend class Pointer; /* will read private data */
+    friend class detail::hasher; /* memoizes hashes */
 };
 
 /***********************/
@@ -584,6 +854,35 @@ Value parse(const char *spec, size_t size);
  */
 Value parse(const std::string& spec);
 
+/**
+ * @brief Creates a new JSON Value by parsing the character string @p spec, keeping the
+ * subtrees at @p raw as JSON text.
+ *
+ * Objects and arrays pointed to by @p raw are not decoded (nor are their children) and are
+ * written verbatim by @c stringify, which makes forwarding large opaque payloads cheap.
+ * They are decoded transparently if accessed later on. Pointers not found in the document
+ * are ignored.
+ *
+ * @param spec The character string to parse
+ * @param size Size of the character string
+ * @param raw Pointers to the subtrees to keep as text
+ *
+ * @return The result JSON
+ *
+ * @exception parse_error
+ *
+ * @remarks Comments are not allowed.
+ */
+Value parse(const char *spec, size_t size, const std::vector<Pointer>& raw);
+
+/**
+ * @brief Creates a new JSON Value by parsing the string @p spec, keeping the subtrees
+ * at @p raw as JSON text.
+ *
+ * @see parse(const char *, size_t, const std::vector<Pointer>&)
+ */
+Value parse(const std::string& spec, const std::vector<Pointer>& raw);
+
 /**
  * @brief Creates a new @c JSON Value by reading on the input stream @p stream.
  *
@@ -595,6 +894,107 @@ Value parse(const std::string& spec);
  */
 Value parse(std::istream& stream);
 
+/**
+ * @brief Creates a new JSON Value by parsing the character string @p spec, storing the
+ * arrays having at least 16 elements packed when possible (see @c Value::pack).
+ *
+ * @param spec The character string to parse
+ * @param size Size of the character string
+ *
+ * @return The result JSON
+ *
+ * @exception parse_error
+ *
+ * @remarks Since even const accessors create the elements of packed arrays, the result
+ * must not be shared between threads without synchronization.
+ */
+Value parse(const char *spec, size_t size, const json_spec_pack&);
+
+/**
+ * @brief Creates a new JSON Value by parsing the string @p spec, storing the large arrays
+ * packed.
+ *
+ * @see parse(const char *, size_t, const json_spec_pack&)
+ */
+Value parse(const std::string& spec, const json_spec_pack&);
+
+/**
+ * @brief Creates a new JSON Value from the character string @p spec, decoding
+ * objects and arrays on demand.
+ *
+ * The syntax of the whole string is checked up front, but the children of an object
+ * or array are only decoded when the node is first accessed (i.e. @c operator[], @c find,
+ * @c size, a @c Pointer). Nodes never accessed are written verbatim by @c stringify.
+ *
+ * @param spec The character string to parse
+ * @param size Size of the character string
+ *
+ * @return The result JSON
+ *
+ * @exception parse_error
+ *
+ * @remarks Comments are not allowed. Since even const accessors decode nodes, lazy
+ * values must not be shared between threads without synchronization.
+ */
+Value parse_lazy(const char *spec, size_t size);
+
+/**
+ * @brief Creates a new JSON Value from the string @p spec, decoding objects and arrays
+ * on demand.
+ *
+ * @see parse_lazy(const char *, size_t)
+ */
+Value parse_lazy(const std::string& spec);
+
+/**
+ * @brief Creates a new @c JSON Value by parsing the content of the file at @p path.
+ *
+ * The file is mapped read-only into memory and parsed straight from the mapping,
+ * avoiding the intermediate copies of a stream. Files that cannot be mapped (e.g.
+ * pipes) are read as a stream.
+ *
+ * @param path Path of the file to parse
+ *
+ * @return The result JSON
+ *
+ * @exception parse_error When the file cannot be opened or its content is invalid
+ */
+Value parse_file(const std::string& path);
+
+/**
+ * @brief Creates a new JSON Value by parsing the content of the file at @p path, storing
+ * the large arrays packed.
+ *
+ * @see parse_file(const std::string&), parse(const char *, size_t, const json_spec_pack&)
+ */
+Value parse_file(const std::string& path, const json_spec_pack&);
+
+/**
+ * @brief Creates a new JSON Value by parsing the character string @p spec, which
+ * holds a (huge) top-level array. The elements of the array are split among
+ * @p threads workers that parse them concurrently.
+ *
+ * @param spec The character string to parse
+ * @param size Size of the character string
+ * @param threads Number of workers, @c 0 means one per hardware thread
+ *
+ * @return The result JSON
+ *
+ * @exception parse_error
+ *
+ * @remarks Inputs other than a top-level array, or having comments, are parsed
+ * sequentially. Errors are reported at the same line and column as @c json::parse.
+ */
+Value parse_parallel(const char *spec, size_t size, unsigned int threads = 0);
+
+/**
+ * @brief Creates a new JSON Value by parsing the string @p spec, which holds
+ * a (huge) top-level array, using @p threads workers.
+ *
+ * @see parse_parallel(const char *, size_t, unsigned int)
+ */
+Value parse_parallel(const std::string& spec, unsigned int threads = 0);
+
 /**
  * @brief JSON IO manipulator. Controls output formatting
  * for @c operator<<
@@ -641,6 +1041,36 @@ inline bool Value::is_object() const {
     return type() == Type::Object;
 }
 
+inline bool Value::operator<(const Value& other) const {
+    return compare(other) < 0;
+}
+
+inline bool Value::operator<=(const Value& other) const {
+    return compare(other) <= 0;
+}
+
+inline bool Value::operator>(const Value& other) const {
+    return compare(other) > 0;
+}
+
+inline bool Value::operator>=(const Value& other) const {
+    return compare(other) >= 0;
+}
+
+inline bool Value::is_raw() const {
+    return !raw_.empty() && raw_.kind() == detail::raw_text::json_text;
+}
+
+inline bool Value::is_packed() const {
+    return !raw_.empty() && raw_.kind() != detail::raw_text::json_text;
+}
+
+inline void Value::expand() const {
+    if (!raw_.empty()) {
+        expand_lazy();
+    }
+}
+
 inline const Value& Value::at(const key_type& key) const {
     return (*this)[key];
 }
@@ -0,0 +1,34 @@
+/*!
+ * \file cbor.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include "json/cbor.hpp"
+
+#include "detail/json_io.hpp"
+
+namespace json {
+
+std::vector<uint8_t> to_cbor(const Value& value) {
+    std::vector<uint8_t> out;
+    detail::IO::print_cbor(value, out);
+    return out;
+}
+
+void to_cbor(const Value& value, std::vector<uint8_t>& out) {
+    detail::IO::print_cbor(value, out);
+}
+
+Value from_cbor(const uint8_t *data, size_t size) {
+    Value val;
+    detail::IO::parse_cbor(val, data, size);
+    return val;
+}
+
+Value from_cbor(const std::vector<uint8_t>& data) {
+    return from_cbor(data.empty() ? nullptr : &data[0], data.size());
+}
+
+} // namespace json
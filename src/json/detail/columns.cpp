@@ -0,0 +1,122 @@
+/*!
+ * \file columns.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * json_object Version 2 - Arrays of objects stored by column
+ */
+
+#include "json/detail/columns.hpp"
+
+namespace json {
+namespace detail {
+
+Value columns::column::at(size_t row) const {
+    switch (kind) {
+        case ints:
+            return Value(int_vals[row]);
+        case dbls:
+            return Value(dbl_vals[row]);
+        case strings:
+            return Value(pool.substr(offsets[row], offsets[row + 1] - offsets[row]));
+        default:
+            return any_vals[row];
+    }
+}
+
+const columns::column *columns::find(const std::string& key) const {
+    size_t first = 0, last = cols.size();
+    while (first < last) {
+        size_t middle = first + (last - first) / 2;
+        int result = cols[middle].key.compare(key);
+        if (result == 0) {
+            return &cols[middle];
+        }
+        if (result < 0) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return nullptr;
+}
+
+/* checks if `obj` is a decoded object having the keys of `first` */
+static bool same_keys(const Value& obj, const Value& first) {
+    if (obj.type() != Type::Object || obj.is_raw() || obj.size() != first.size()) {
+        return false;
+    }
+    for (Value::const_iterator it = obj.begin(), fit = first.begin(), end = obj.end(); it != end; ++it, ++fit) {
+        if (it->first != fit->first) {
+            return false;
+        }
+    }
+    return true;
+}
+
+columns *columns::build(const Value::array_type& array) {
+    if (array.empty() || array.front().type() != Type::Object || array.front().empty()) {
+        return nullptr;
+    }
+    for (Value::const_array_iterator it = array.begin(), end = array.end(); it != end; ++it) {
+        if (!same_keys(*it, array.front())) {
+            return nullptr;
+        }
+    }
+
+    columns *table = new columns();
+    table->rows = array.size();
+    table->cols.resize(array.front().size());
+
+    std::vector<column>::iterator col = table->cols.begin();
+    for (Value::const_iterator kit = array.front().begin(), kend = array.front().end(); kit != kend; ++kit, ++col) {
+        col->key = kit->first;
+
+        // typed if all the rows have the same scalar type
+        Type::Value type = kit->second.type();
+        for (Value::const_array_iterator it = array.begin(), end = array.end(); it != end && type != Type::Null; ++it) {
+            if ((*it)[kit->first].type() != type) {
+                type = Type::Null;
+            }
+        }
+
+        switch (type) {
+            case Type::Integer:
+                col->kind = column::ints;
+                col->int_vals.reserve(array.size());
+                for (Value::const_array_iterator it = array.begin(), end = array.end(); it != end; ++it) {
+                    col->int_vals.push_back((*it)[kit->first].to_int());
+                }
+                break;
+            case Type::Double:
+                col->kind = column::dbls;
+                col->dbl_vals.reserve(array.size());
+                for (Value::const_array_iterator it = array.begin(), end = array.end(); it != end; ++it) {
+                    col->dbl_vals.push_back((*it)[kit->first].to_double());
+                }
+                break;
+            case Type::String:
+                col->kind = column::strings;
+                col->offsets.reserve(array.size() + 1);
+                col->offsets.push_back(0);
+                for (Value::const_array_iterator it = array.begin(), end = array.end(); it != end; ++it) {
+                    col->pool += (*it)[kit->first].to_string();
+                    col->offsets.push_back(col->pool.size());
+                }
+                break;
+            default:
+                col->kind = column::values;
+                col->any_vals.reserve(array.size());
+                for (Value::const_array_iterator it = array.begin(), end = array.end(); it != end; ++it) {
+                    col->any_vals.push_back((*it)[kit->first]); // containers are shared, not copied
+                }
+                break;
+        }
+    }
+
+    return table;
+}
+
+} // namespace detail
+} // namespace json
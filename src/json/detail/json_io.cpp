@@ -7,17 +7,37 @@
  * json_object Version 2 - Parser, Printer
  */
 #include "json_io.hpp"
+#include "mapped_file.hpp"
+#include "tape_format.hpp"
 
+#include "json/detail/columns.hpp"
 #include "json/errors.hpp"
+#include "json/parser.hpp"
 
 #include "libjson/json.h"
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+#if JSON_HAVE_CXX11
+#include <functional>
+#include <system_error>
+#include <thread>
+#endif
+
 namespace json {
 namespace detail {
 
+/* arrays having at least this many elements are packed by the parser, if asked to (see option_pack) */
+static const size_t min_packed_size = 16;
+
 class IO::parser_context {
 public:
     bool                top_level;
+    bool                pack;           /* packs the large arrays, if possible */
+    bool                pack_top_level; /* packs the array parsed into the target too */
     int                 err_code_;
     std::vector<Value*> stack_;
     json_config         config_;
@@ -25,54 +45,77 @@ public:
     std::string         key_;
 
 public:
+    parser_context()
+        : top_level(true),
+          pack(false),
+          pack_top_level(true) {
+        init();
+    }
+
     parser_context(Value& obj)
-        : top_level(true) {
-        stack_.reserve(32);
+        : top_level(true),
+          pack(false),
+          pack_top_level(true) {
+        init();
         stack_.push_back(&obj);
-
-        memset(&config_, 0, sizeof(config_));
-        config_.max_nesting = 1024;
-        config_.max_data = 1 << 27;
-        config_.allow_c_comments = 1;
-
-        err_code_ = json_parser_init(&parser_, &config_, &parser_callback, this);
     }
 
     ~parser_context() {
         json_parser_free(&parser_);
     }
 
+    /* prepares the context to parse a new document into `obj`, buffers are kept */
+    void reset(Value& obj) {
+        top_level = true;
+        stack_.clear();
+        stack_.push_back(&obj);
+        err_code_ = json_parser_reset(&parser_);
+    }
+
     int err_code() const {
         return err_code_;
     }
 
-    int parse(const std::string& str, uint32_t& line, uint32_t& column) {
+    /* feeds `size` bytes to the parser, `processed` is set to the amount of bytes consumed */
+    int feed(const char *data, size_t size, size_t& processed) {
+        static const size_t max_slice = 1u << 30; // libjson takes 32-bit lengths
+
+        processed = 0;
+        while (err_code_ == 0 && processed < size) {
+            uint32_t count = 0;
+            err_code_ = json_parser_string(&parser_,
+                                           data + processed,
+                                           static_cast<uint32_t>(std::min(size - processed, max_slice)),
+                                           &count);
+            processed += count;
+        }
+
+        return err_code_;
+    }
+
+    bool done() {
+        return json_parser_is_done(&parser_) != 0;
+    }
+
+    int parse(const char *data, size_t size, uint32_t& line, uint32_t& column) {
         if (err_code_ != 0) {
             return err_code_;
         }
 
-        uint32_t processed = 0;
-        err_code_ = json_parser_string(&parser_,
-                                       str.c_str(),
-                                       static_cast<uint32_t>(str.size()),
-                                       &processed);
-        if (err_code_ || !json_parser_is_done(&parser_)) {
+        size_t processed = 0;
+        if (feed(data, size, processed) || !done()) {
             line = 1;
             column = 1;
-            for (uint32_t i = 0; i < processed; ++i) {
-                if (str[i] == '\n') {
-                    ++line;
-                    column = 1;
-                } else {
-                    ++column;
-                }
-            }
+            advance(data, processed, line, column);
             err_code_ = err_code_ ? err_code_ : JSON_ERROR_UTF8 + 1;
         }
 
         return err_code_;
     }
 
+    int parse(const std::string& str, uint32_t& line, uint32_t& column) {
+        return parse(str.data(), str.size(), line, column);
+    }
 
     int parse(std::istream& stream, uint32_t &line, uint32_t &column) {
         if (err_code_ != 0) {
@@ -101,14 +144,7 @@ public:
                 return err_code_;
             }
 
-            for (uint32_t i = 0; i < processed; ++i) {
-                if (buffer[i] == '\n') {
-                    ++line;
-                    column = 1;
-                } else {
-                    ++column;
-                }
-            }
+            advance(buffer, processed, line, column);
 
             if (err_code_) {
                 break;
@@ -122,15 +158,40 @@ public:
         return err_code_;
     }
 
+    /* moves the (line, column) position past the first `count` bytes of `data` */
+    static void advance(const char *data, size_t count, uint32_t& line, uint32_t& column) {
+        for (size_t i = 0; i < count; ++i) {
+            if (data[i] == '\n') {
+                ++line;
+                column = 1;
+            } else {
+                ++column;
+            }
+        }
+    }
+
 private:
 
+    void init() {
+        stack_.reserve(32);
+
+        memset(&config_, 0, sizeof(config_));
+        config_.max_nesting = 1024;
+        config_.max_data = 1 << 27;
+        config_.allow_c_comments = 1;
+
+        err_code_ = json_parser_init(&parser_, &config_, &parser_callback, this);
+    }
+
     Value& set_json_value(Value& obj, const std::string& key, const Value& val) {
         switch (obj.type()) {
             case Type::Object:
-                return (obj.value_.map_val[key] = val);
-            case Type::Array:
-                obj.value_.arr_val.push_back(val);
-                return obj.value_.arr_val.back();
+                return (obj.value_.map_val.write()[key] = val);
+            case Type::Array: {
+                Value::array_type& array = obj.value_.arr_val.write();
+                array.push_back(val);
+                return array.back();
+            }
             default:
                 throw std::runtime_error("Unexpected json type");
         }
@@ -167,50 +228,106 @@ private:
         return false;
     }
 
-    int parser_callback_impl(int type, const char *data, unsigned int length) {
+public:
+    /* the events of the parser, also raised by the decoders of binary formats */
+
+    void begin_object() {
         Value *obj = stack_.back();
+        if (top_level) {
+            top_level = false;
+            *obj = Value();
+        } else {
+            stack_.push_back(&set_json_value(*obj, key_, Value()));
+        }
+    }
+
+    /* `reserve` is the number of elements, when known beforehand */
+    void begin_array(size_t reserve = 0) {
+        Value *obj = stack_.back();
+        if (top_level) {
+            top_level = false;
+            *obj = Value::array_type();
+        } else {
+            obj = &set_json_value(*obj, key_, Value::array_type());
+            stack_.push_back(obj);
+        }
+        if (reserve > 0) {
+            obj->value_.arr_val.write().reserve(reserve);
+        }
+    }
 
+    void end_object() {
+        stack_.pop_back();
+    }
+
+    void end_array() {
+        Value *obj = stack_.back();
+        stack_.pop_back();
+        if (pack && obj->value_.arr_val->size() >= min_packed_size && (pack_top_level || !stack_.empty())) {
+            obj->pack();
+        }
+    }
+
+    void set_key(const char *data, size_t length) {
+        key_.assign(data, length); // reuses the buffer
+    }
+
+    void add_value(const Value& val) {
+        if (top_level) { // only binary formats have scalars at the top level
+            top_level = false;
+            *stack_.back() = val;
+        } else {
+            set_json_value(*stack_.back(), key_, val);
+        }
+    }
+
+    void add_string(const char *data, size_t length) {
+        if (top_level) {
+            top_level = false;
+            *stack_.back() = std::string(data, length);
+            return;
+        }
+        // decoded in place, not copied from a temporary
+        Value& str = set_json_value(*stack_.back(), key_, Value::Null);
+        str.type_ = Type::String;
+        str.value_.str_val.assign(data, length);
+    }
+
+private:
+    int parser_callback_impl(int type, const char *data, unsigned int length) {
         switch (type) {
             case JSON_OBJECT_BEGIN:
-                if (top_level) {
-                    top_level = false;
-                    *obj = Value();
-                } else {
-                    stack_.push_back(&set_json_value(*obj, key_, Value()));
-                }
+                begin_object();
                 break;
             case JSON_ARRAY_BEGIN:
-                if (top_level) {
-                    top_level = false;
-                    *obj = Value::array_type();
-                } else {
-                    stack_.push_back(&set_json_value(*obj, key_, Value::array_type()));
-                }
+                begin_array();
                 break;
             case JSON_OBJECT_END:	//one level back
+                end_object();
+                break;
             case JSON_ARRAY_END:
-                stack_.pop_back();
+                end_array();
                 break;
             case JSON_KEY:
-                key_ = std::string(data, length);
+                set_key(data, length);
                 break;
             case JSON_TRUE:
-                set_json_value(*obj, key_, true);
+                add_value(true);
                 break;
             case JSON_FALSE:
-                set_json_value(*obj, key_, false);
+                add_value(false);
                 break;
             case JSON_NULL:
-                set_json_value(*obj, key_, Value::Null);
+                add_value(Value::Null);
                 break;
             case JSON_STRING:
-                set_json_value(*obj, key_, std::string(data, length));
+                add_string(data, length);
                 break;
             case JSON_INT:
-                set_json_value(*obj, key_, detail::stoi64(data));
+                add_value(detail::stoi64(data));
                 break;
             case JSON_FLOAT:
-                set_json_value(*obj, key_, detail::stod(data));
+                add_value(detail::stod(data));
                 break;
             default:
                 return -1;
@@ -224,10 +341,310 @@ private:
     }
 };
 
+/* whitespace as defined by the JSON grammar */
+static inline bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+#if JSON_HAVE_CXX11
+/* A run of consecutive elements of a top-level array, parsed by one worker */
+class IO::parallel_chunk {
+public:
+    const char *begin;
+    size_t      size;
+    Value       result;
+    bool        ok;
+
+    parallel_chunk(const char *begin, size_t size)
+        : begin(begin),
+          size(size),
+          ok(false) {
+    }
+
+    void operator()() {
+        try {
+            // the elements are wrapped in brackets so they are parsed as an array
+            size_t processed = 0;
+            parser_context context(result);
+            ok = context.feed("[", 1, processed) == 0
+                    && context.feed(begin, size, processed) == 0
+                    && context.feed("]", 1, processed) == 0
+                    && context.done();
+        } catch (...) {
+            ok = false; // the sequential parser reports it
+        }
+    }
+};
+
+/*
+ * Scans the top-level array in `spec` and stores the offsets of the opening
+ * bracket, the separating commas and the closing bracket in `bounds`.
+ * Returns false if the input is not a plain top-level array, e.g. objects,
+ * arrays having comments and malformed input.
+ */
+static bool scan_array(const char *spec, size_t size, std::vector<size_t>& bounds) {
+    size_t i = 0;
+    while (i < size && is_blank(spec[i])) {
+        ++i;
+    }
+    if (i == size || spec[i] != '[') {
+        return false;
+    }
+
+    bounds.push_back(i);
+
+    size_t depth = 1;
+    for (++i; i < size; ++i) {
+        switch (spec[i]) {
+            case '"':
+                for (++i; i < size && spec[i] != '"'; ++i) {
+                    if (spec[i] == '\\') {
+                        ++i;
+                    }
+                }
+                break;
+            case '[':
+            case '{':
+                ++depth;
+                break;
+            case ']':
+            case '}':
+                if (--depth == 0) {
+                    if (spec[i] != ']') {
+                        return false; // the parser reports it
+                    }
+                    bounds.push_back(i);
+                    for (++i; i < size && is_blank(spec[i]); ++i);
+                    return i == size;
+                }
+                break;
+            case ',':
+                if (depth == 1) {
+                    bounds.push_back(i);
+                }
+                break;
+            case '/':
+                return false; // comments
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
+#endif
+
+/* skips JSON whitespace */
+static inline const char *skip_blank(const char *it, const char *end) {
+    while (it != end && is_blank(*it)) {
+        ++it;
+    }
+    return it;
+}
+
+/* returns the end of the (valid) JSON value starting at `it` */
+static const char *skip_value(const char *it, const char *end) {
+    size_t depth = 0;
+    do {
+        switch (*it) {
+            case '"':
+                for (++it; *it != '"'; ++it) {
+                    if (*it == '\\') {
+                        ++it;
+                    }
+                }
+                ++it;
+                break;
+            case '[':
+            case '{':
+                ++depth;
+                ++it;
+                break;
+            case ']':
+            case '}':
+                --depth;
+                ++it;
+                break;
+            default:
+                if (depth == 0) { // literal or number
+                    while (it != end && !is_blank(*it) && *it != ',' && *it != ']' && *it != '}') {
+                        ++it;
+                    }
+                } else {
+                    ++it;
+                }
+                break;
+        }
+    } while (depth > 0);
+    return it;
+}
+
+/* appends the code point `cp` to `out` encoded as UTF-8 */
+static void append_utf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xc0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3f));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xe0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (cp & 0x3f));
+    } else {
+        out += static_cast<char>(0xf0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3f));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (cp & 0x3f));
+    }
+}
+
+/* decodes the (valid) string literal starting at `it` into `out`, returns its end */
+static const char *decode_string(const char *it, std::string& out) {
+    out.clear();
+    const char *chunk = ++it;
+    for (; *it != '"'; ++it) {
+        if (*it != '\\') {
+            continue;
+        }
+        out.append(chunk, it);
+        switch (*++it) {
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                uint32_t cp = static_cast<uint32_t>(strtoul(std::string(it + 1, 4).c_str(), nullptr, 16));
+                it += 4;
+                if ((cp & 0xfc00) == 0xd800) { // high surrogate, followed by \uXXXX
+                    uint32_t low = static_cast<uint32_t>(strtoul(std::string(it + 3, 4).c_str(), nullptr, 16));
+                    cp = 0x10000 + ((cp & 0x3ff) << 10) + (low & 0x3ff);
+                    it += 6;
+                }
+                append_utf8(out, cp);
+                break;
+            }
+            default: out += *it; break; // quote, slashes
+        }
+        chunk = it + 1;
+    }
+    out.append(chunk, it);
+    return it + 1;
+}
+
+/* runs `parser` over the whole of `spec`, on error (line, column) is set to where it stopped */
+static int run_parser(json_parser& parser, const char *spec, size_t size, uint32_t& line, uint32_t& column) {
+    static const size_t max_slice = 1u << 30; // libjson takes 32-bit lengths
+
+    int err_code = 0;
+    size_t processed = 0;
+    while (err_code == 0 && processed < size) {
+        uint32_t count = 0;
+        err_code = json_parser_string(&parser,
+                                      spec + processed,
+                                      static_cast<uint32_t>(std::min(size - processed, max_slice)),
+                                      &count);
+        processed += count;
+    }
+
+    if (err_code || !json_parser_is_done(&parser)) {
+        line = 1;
+        column = 1;
+        IO::parser_context::advance(spec, processed, line, column);
+        err_code = err_code ? err_code : JSON_ERROR_UTF8 + 1;
+    }
+
+    return err_code;
+}
+
+/* checks the syntax of `spec` without building anything, comments are not allowed */
+static int validate(const char *spec, size_t size, uint32_t& line, uint32_t& column) {
+    json_config config;
+    memset(&config, 0, sizeof(config));
+    config.max_nesting = 1024;
+    config.max_data = 1 << 27;
+
+    json_parser parser;
+    int err_code = json_parser_init(&parser, &config, nullptr, nullptr);
+    if (err_code == 0) {
+        err_code = run_parser(parser, spec, size, line, column);
+    }
+
+    json_parser_free(&parser);
+    return err_code;
+}
+
+/* Appends the words of a tape as the parser reports the values */
+class IO::tape_context {
+public:
+    bool too_large; /* a container does not fit in a tape */
+
+    tape_context(std::vector<uint64_t>& words, std::vector<char>& strings)
+        : too_large(false),
+          writer_(words, strings, false) {
+    }
+
+    static int callback(void *userdata, int type, const char *data, uint32_t length) {
+        return static_cast<tape_context*>(userdata)->callback_impl(type, data, length);
+    }
+
+private:
+    tape::writer writer_;
+
+    int callback_impl(int type, const char *data, uint32_t length) {
+        switch (type) {
+            case JSON_OBJECT_BEGIN:
+                writer_.open(tape::object_tag);
+                break;
+            case JSON_ARRAY_BEGIN:
+                writer_.open(tape::array_tag);
+                break;
+            case JSON_OBJECT_END:
+                return close(tape::object_end);
+            case JSON_ARRAY_END:
+                return close(tape::array_end);
+            case JSON_KEY:
+                writer_.key(data, length);
+                break;
+            case JSON_TRUE:
+                writer_.literal(tape::true_tag);
+                break;
+            case JSON_FALSE:
+                writer_.literal(tape::false_tag);
+                break;
+            case JSON_NULL:
+                writer_.literal(tape::null_tag);
+                break;
+            case JSON_STRING:
+                writer_.string(data, length);
+                break;
+            case JSON_INT:
+                writer_.integer(detail::stoi64(data));
+                break;
+            case JSON_FLOAT:
+                writer_.real(detail::stod(data));
+                break;
+            default:
+                return -1;
+        }
+
+        return 0;
+    }
+
+    int close(tape::tag t) {
+        if (!writer_.close(t)) {
+            too_large = true;
+            return -1;
+        }
+        return 0;
+    }
+};
+
 class IO::writer_context {
     const Value& obj;
     json_printer printer_;
     std::ostream *stream_;
+    bool pretty_;
 public:
     writer_context(const Value& obj)
         : obj(obj) {
@@ -240,6 +657,7 @@ public:
 
     void print(std::ostream& os, bool pretty) {
         stream_ = &os;
+        pretty_ = pretty;
         deep_print(obj, pretty ? json_print_pretty : json_print_raw);
     }
 
@@ -248,8 +666,74 @@ public:
         return 0;
     }
 
+    /* writes the elements of a packed array as if they were created */
+    void print_packed(const Value& obj,
+                      int(*print_function)(json_printer*, int, const char *, uint32_t)) {
+        if (obj.raw_.kind() != raw_text::column_table) {
+            print_function(&printer_, JSON_ARRAY_BEGIN, nullptr, 0);
+            for (size_t i = 0, count = obj.raw_.count(); i < count; ++i) {
+                if (obj.raw_.kind() == raw_text::packed_int) {
+                    std::string str = detail::to_string(obj.raw_.values<int64_t>()[i]);
+                    print_function(&printer_, JSON_INT, str.c_str(), static_cast<uint32_t>(str.size()));
+                } else {
+                    std::string str = detail::to_string(obj.raw_.values<double>()[i]);
+                    print_function(&printer_, JSON_FLOAT, str.c_str(), static_cast<uint32_t>(str.size()));
+                }
+            }
+            print_function(&printer_, JSON_ARRAY_END, nullptr, 0);
+            return;
+        }
+
+        const columns& table = obj.raw_.table();
+        print_function(&printer_, JSON_ARRAY_BEGIN, nullptr, 0);
+        for (size_t row = 0; row < table.rows; ++row) {
+            print_function(&printer_, JSON_OBJECT_BEGIN, nullptr, 0);
+            for (std::vector<columns::column>::const_iterator col = table.cols.begin(), end = table.cols.end(); col != end; ++col) {
+                print_function(&printer_, JSON_KEY, col->key.c_str(), static_cast<uint32_t>(col->key.length()));
+                switch (col->kind) {
+                    case columns::column::ints: {
+                        std::string str = detail::to_string(col->int_vals[row]);
+                        print_function(&printer_, JSON_INT, str.c_str(), static_cast<uint32_t>(str.size()));
+                        break;
+                    }
+                    case columns::column::dbls: {
+                        std::string str = detail::to_string(col->dbl_vals[row]);
+                        print_function(&printer_, JSON_FLOAT, str.c_str(), static_cast<uint32_t>(str.size()));
+                        break;
+                    }
+                    case columns::column::strings:
+                        print_function(&printer_, JSON_STRING, col->pool.data() + col->offsets[row],
+                                       static_cast<uint32_t>(col->offsets[row + 1] - col->offsets[row]));
+                        break;
+                    default:
+                        deep_print(col->any_vals[row], print_function);
+                        break;
+                }
+            }
+            print_function(&printer_, JSON_OBJECT_END, nullptr, 0);
+        }
+        print_function(&printer_, JSON_ARRAY_END, nullptr, 0);
+    }
+
     void deep_print(const Value& obj,
                     int(*print_function)(json_printer*, int, const char *, uint32_t)) {
+        if (obj.is_packed()) {
+            print_packed(obj, print_function);
+            return;
+        }
+
+        if (!obj.raw_.empty()) {
+            if (!pretty_) {
+                // not decoded yet, written verbatim (numbers are written as-is)
+                print_function(&printer_, JSON_INT, obj.raw_.data(), static_cast<uint32_t>(obj.raw_.size()));
+            } else {
+                Value copy(obj);
+                expand(copy);
+                deep_print(copy, print_function);
+            }
+            return;
+        }
+
         switch (obj.type_) {
             case Type::Null: {
                 print_function(&printer_, JSON_NULL, nullptr, 0);
@@ -275,7 +759,7 @@ public:
             }
             case Type::Array: {
                 print_function(&printer_, JSON_ARRAY_BEGIN, nullptr, 0);
-                Value::const_array_iterator it = obj.value_.arr_val.begin(), end = obj.value_.arr_val.end();
+                Value::const_array_iterator it = obj.value_.arr_val->begin(), end = obj.value_.arr_val->end();
                 for (; it != end; ++it) {
                     deep_print(*it, print_function);
                 }
@@ -284,7 +768,7 @@ public:
             }
             case Type::Object: {
                 print_function(&printer_, JSON_OBJECT_BEGIN, nullptr, 0);
-                Value::const_iterator it = obj.value_.map_val.begin(), end = obj.value_.map_val.end();
+                Value::const_iterator it = obj.value_.map_val->begin(), end = obj.value_.map_val->end();
                 for (; it != end; ++it) {
                     print_function(&printer_, JSON_KEY, it->first.c_str(), static_cast<uint32_t>(it->first.length()));
                     deep_print(it->second, print_function);
@@ -297,6 +781,406 @@ public:
 };
 
 
+/* Encodes values as CBOR (RFC 8949), using the preferred (shortest) serialization */
+class IO::cbor_writer {
+public:
+    explicit cbor_writer(std::vector<uint8_t>& out)
+        : out_(out) {
+    }
+
+    void write(const Value& obj) {
+        if (obj.is_packed()) {
+            write_packed(obj);
+            return;
+        }
+
+        if (!obj.raw_.empty()) { // not decoded yet
+            Value copy(obj);
+            expand(copy);
+            write(copy);
+            return;
+        }
+
+        switch (obj.type_) {
+            case Type::Null:
+                out_.push_back(0xf6);
+                break;
+            case Type::Boolean:
+                out_.push_back(obj.value_.bool_val ? 0xf5 : 0xf4);
+                break;
+            case Type::Integer:
+                integer(obj.value_.int_val);
+                break;
+            case Type::Double:
+                real(obj.value_.dbl_val);
+                break;
+            case Type::String:
+                string(obj.value_.str_val.data(), obj.value_.str_val.size());
+                break;
+            case Type::Array: {
+                head(array_type, obj.value_.arr_val->size());
+                Value::const_array_iterator it = obj.value_.arr_val->begin(), end = obj.value_.arr_val->end();
+                for (; it != end; ++it) {
+                    write(*it);
+                }
+                break;
+            }
+            case Type::Object: {
+                head(map_type, obj.value_.map_val->size());
+                Value::const_iterator it = obj.value_.map_val->begin(), end = obj.value_.map_val->end();
+                for (; it != end; ++it) {
+                    string(it->first.data(), it->first.size());
+                    write(it->second);
+                }
+                break;
+            }
+        }
+    }
+
+private:
+    enum major_type {
+        unsigned_type = 0,
+        negative_type = 1,
+        text_type     = 3,
+        array_type    = 4,
+        map_type      = 5
+    };
+
+    std::vector<uint8_t>& out_;
+
+    /* writes the elements of a packed array as if they were created */
+    void write_packed(const Value& obj) {
+        if (obj.raw_.kind() != raw_text::column_table) {
+            size_t count = obj.raw_.count();
+            head(array_type, count);
+            for (size_t i = 0; i < count; ++i) {
+                if (obj.raw_.kind() == raw_text::packed_int) {
+                    integer(obj.raw_.values<int64_t>()[i]);
+                } else {
+                    real(obj.raw_.values<double>()[i]);
+                }
+            }
+            return;
+        }
+
+        const columns& table = obj.raw_.table();
+        head(array_type, table.rows);
+        for (size_t row = 0; row < table.rows; ++row) {
+            head(map_type, table.cols.size());
+            for (std::vector<columns::column>::const_iterator col = table.cols.begin(), end = table.cols.end(); col != end; ++col) {
+                string(col->key.data(), col->key.size());
+                switch (col->kind) {
+                    case columns::column::ints:
+                        integer(col->int_vals[row]);
+                        break;
+                    case columns::column::dbls:
+                        real(col->dbl_vals[row]);
+                        break;
+                    case columns::column::strings:
+                        string(col->pool.data() + col->offsets[row], col->offsets[row + 1] - col->offsets[row]);
+                        break;
+                    default:
+                        write(col->any_vals[row]);
+                        break;
+                }
+            }
+        }
+    }
+
+    /* the initial byte, followed by the argument in as few bytes as possible */
+    void head(major_type major, uint64_t argument) {
+        uint8_t initial = static_cast<uint8_t>(major << 5);
+        if (argument < 24) {
+            out_.push_back(static_cast<uint8_t>(initial | argument));
+        } else if (argument <= 0xff) {
+            out_.push_back(initial | 24);
+            big_endian(argument, 1);
+        } else if (argument <= 0xffff) {
+            out_.push_back(initial | 25);
+            big_endian(argument, 2);
+        } else if (argument <= 0xffffffffu) {
+            out_.push_back(initial | 26);
+            big_endian(argument, 4);
+        } else {
+            out_.push_back(initial | 27);
+            big_endian(argument, 8);
+        }
+    }
+
+    void big_endian(uint64_t value, int bytes) {
+        for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+            out_.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    void integer(int64_t value) {
+        if (value >= 0) {
+            head(unsigned_type, static_cast<uint64_t>(value));
+        } else {
+            head(negative_type, static_cast<uint64_t>(-(value + 1)));
+        }
+    }
+
+    /* single precision when no precision is lost */
+    void real(double value) {
+        float single = 0; // narrowing out of range is undefined
+        if (std::fabs(value) <= std::numeric_limits<float>::max()) {
+            single = static_cast<float>(value);
+        }
+        if (static_cast<double>(single) == value) {
+            uint32_t bits;
+            memcpy(&bits, &single, sizeof(bits));
+            out_.push_back(0xfa);
+            big_endian(bits, 4);
+        } else {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            out_.push_back(0xfb);
+            big_endian(bits, 8);
+        }
+    }
+
+    void string(const char *data, size_t size) {
+        head(text_type, size);
+        out_.insert(out_.end(), data, data + size);
+    }
+};
+
+/* Decodes a CBOR (RFC 8949) data item, the values are built by the events of parser_context */
+class IO::cbor_reader {
+public:
+    cbor_reader(const uint8_t *data, size_t size)
+        : begin_(data),
+          it_(data),
+          end_(data + size) {
+    }
+
+    void read(parser_context& context) {
+        static const size_t max_nesting = 1024; // as the text parser
+
+        std::vector<frame> frames;
+        do {
+            if (!frames.empty()) {
+                frame& top = frames.back();
+                if (top.indefinite ? (it_ < end_ && *it_ == 0xff) : top.remaining == 0) {
+                    it_ += top.indefinite ? 1 : 0; // the break
+                    if (top.map) {
+                        context.end_object();
+                    } else {
+                        context.end_array();
+                    }
+                    frames.pop_back();
+                    continue;
+                }
+                if (!top.indefinite) {
+                    --top.remaining;
+                }
+                if (top.map) {
+                    item key = read_head();
+                    if (key.major != 2 && key.major != 3) {
+                        fail("map keys must be strings");
+                    }
+                    read_string(key);
+                    context.set_key(string_, string_size_);
+                }
+            }
+
+            item value = read_head();
+            switch (value.major) {
+                case 0:
+                    if (value.argument > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                        fail("integer out of range");
+                    }
+                    context.add_value(static_cast<int64_t>(value.argument));
+                    break;
+                case 1:
+                    if (value.argument > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                        fail("integer out of range");
+                    }
+                    context.add_value(-1 - static_cast<int64_t>(value.argument));
+                    break;
+                case 2: // byte strings are taken as strings
+                case 3:
+                    read_string(value);
+                    context.add_string(string_, string_size_);
+                    break;
+                case 4:
+                case 5:
+                    if (frames.size() >= max_nesting) {
+                        fail("reach nesting limit");
+                    }
+                    if (value.major == 4) {
+                        // each element takes a byte at least
+                        context.begin_array(value.indefinite ? 0 : static_cast<size_t>(std::min<uint64_t>(value.argument, end_ - it_)));
+                    } else {
+                        context.begin_object();
+                    }
+                    frames.push_back(frame(value));
+                    break;
+                default:
+                    context.add_value(simple(value));
+                    break;
+            }
+        } while (!frames.empty());
+
+        if (it_ != end_) {
+            fail("unexpected data after the item");
+        }
+    }
+
+private:
+    /* the head of a data item */
+    struct item {
+        uint8_t  major;
+        uint8_t  info;       /* the additional information */
+        uint64_t argument;
+        bool     indefinite;
+    };
+
+    /* an array or map being decoded */
+    struct frame {
+        uint64_t remaining; /* items, or pairs of items */
+        bool     indefinite;
+        bool     map;
+
+        explicit frame(const item& head)
+            : remaining(head.argument),
+              indefinite(head.indefinite),
+              map(head.major == 5) {
+        }
+    };
+
+    const uint8_t *begin_;
+    const uint8_t *it_;
+    const uint8_t *end_;
+    std::string    chunks_;      /* the chunks of an indefinite-length string, joined */
+    const char    *string_;      /* the last string read */
+    size_t         string_size_;
+
+    void fail(const char *reason) const {
+        throw parse_error(std::string("invalid CBOR at byte ") + detail::to_string(static_cast<uint64_t>(it_ - begin_)) + ": " + reason);
+    }
+
+    void need(uint64_t bytes) const {
+        if (bytes > static_cast<uint64_t>(end_ - it_)) {
+            fail("unexpected end of data");
+        }
+    }
+
+    uint64_t big_endian(int bytes) {
+        need(bytes);
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value = (value << 8) | *it_++;
+        }
+        return value;
+    }
+
+    /* reads the head of the next item, tags are skipped */
+    item read_head() {
+        item result;
+        do {
+            need(1);
+            result.major = static_cast<uint8_t>(*it_ >> 5);
+            result.info = static_cast<uint8_t>(*it_ & 0x1f);
+            result.indefinite = false;
+            ++it_;
+
+            if (result.info < 24) {
+                result.argument = result.info;
+            } else if (result.info <= 27) {
+                result.argument = big_endian(1 << (result.info - 24));
+            } else if (result.info == 31 && result.major >= 2 && result.major != 6) {
+                result.argument = 0;
+                result.indefinite = true;
+            } else {
+                fail("malformed item");
+            }
+        } while (result.major == 6);
+        return result;
+    }
+
+    /* points string_ at the content of the string having head `head` */
+    void read_string(const item& head) {
+        if (!head.indefinite) {
+            need(head.argument);
+            string_ = reinterpret_cast<const char*>(it_);
+            string_size_ = static_cast<size_t>(head.argument);
+            it_ += string_size_;
+            return;
+        }
+
+        chunks_.clear();
+        for (need(1); *it_ != 0xff; need(1)) {
+            item chunk = read_head();
+            if (chunk.major != head.major || chunk.indefinite) {
+                fail("malformed indefinite-length string");
+            }
+            need(chunk.argument);
+            chunks_.append(reinterpret_cast<const char*>(it_), static_cast<size_t>(chunk.argument));
+            it_ += chunk.argument;
+        }
+        ++it_; // the break
+        string_ = chunks_.data();
+        string_size_ = chunks_.size();
+    }
+
+    /* simple values and floating-point numbers */
+    Value simple(const item& head) const {
+        switch (head.info) {
+            case 20:
+                return false;
+            case 21:
+                return true;
+            case 22:
+            case 23: // undefined
+                return Value::Null;
+            case 25:
+                return finite(half(static_cast<uint16_t>(head.argument)));
+            case 26: {
+                uint32_t bits = static_cast<uint32_t>(head.argument);
+                float value;
+                memcpy(&value, &bits, sizeof(value));
+                return finite(static_cast<double>(value));
+            }
+            case 27: {
+                double value;
+                memcpy(&value, &head.argument, sizeof(value));
+                return finite(value);
+            }
+            case 31:
+                fail("unexpected break");
+                return Value::Null;
+            default:
+                fail("unsupported simple value");
+                return Value::Null;
+        }
+    }
+
+    /* JSON has no NaN nor infinity */
+    double finite(double value) const {
+        if (!(value - value == 0)) {
+            fail("NaN or infinity");
+        }
+        return value;
+    }
+
+    static double half(uint16_t bits) {
+        int exponent = (bits >> 10) & 0x1f;
+        int mantissa = bits & 0x3ff;
+        double value;
+        if (exponent == 0) {
+            value = std::ldexp(static_cast<double>(mantissa), -24);
+        } else if (exponent != 31) {
+            value = std::ldexp(static_cast<double>(mantissa + 1024), exponent - 25);
+        } else {
+            value = mantissa == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+        }
+        return (bits & 0x8000) ? -value : value;
+    }
+};
+
+
 static const char *error2string(int errcode) {
     static const int MAX_ERROR = JSON_ERROR_UTF8 + 1;
     static const char *error_strings[] = {
@@ -328,14 +1212,303 @@ void IO::parse(Value& target, const std::string& spec) {
     }
 }
 
-void IO::parse(Value &target, std::istream& stream) {
+void IO::parse(Value &target, std::istream& stream, bool pack) {
+    uint32_t line = 0, column = 0;
+    IO::parser_context context(target);
+    context.pack = pack;
+    if (context.parse(stream, line, column) != 0) {
+        throw parse_error(error2string(context.err_code()), line, column);
+    }
+}
+
+void IO::parse(Value& target, const char *spec, size_t size, bool pack) {
     uint32_t line = 0, column = 0;
     IO::parser_context context(target);
+    context.pack = pack;
+    if (context.parse(spec, size, line, column) != 0) {
+        throw parse_error(error2string(context.err_code()), line, column);
+    }
+}
+
+void IO::parse(parser_context& context, Value& target, const char *spec, size_t size) {
+    uint32_t line = 0, column = 0;
+    context.reset(target);
+    if (context.parse(spec, size, line, column) != 0) {
+        throw parse_error(error2string(context.err_code()), line, column);
+    }
+}
+
+void IO::parse(parser_context& context, Value& target, std::istream& stream) {
+    uint32_t line = 0, column = 0;
+    context.reset(target);
     if (context.parse(stream, line, column) != 0) {
         throw parse_error(error2string(context.err_code()), line, column);
     }
 }
 
+void IO::parse_lazy(Value& target, const char *spec, size_t size) {
+    uint32_t line = 0, column = 0;
+    int err_code = validate(spec, size, line, column);
+    if (err_code != 0) {
+        throw parse_error(error2string(err_code), line, column);
+    }
+
+    const char *begin = skip_blank(spec, spec + size);
+    const char *end = skip_value(begin, spec + size);
+    target = *begin == '{' ? Value() : Value(Value::array_type());
+    target.raw_ = raw_text(begin, static_cast<size_t>(end - begin));
+}
+
+void IO::parse_raw(Value& target, const char *spec, size_t size, const std::vector<Pointer>& raw) {
+    parse_lazy(target, spec, size);
+
+    // resolving a pointer decodes the path to the node, but not the node itself
+    std::set<const Value*> keep;
+    for (std::vector<Pointer>::const_iterator it = raw.begin(), end = raw.end(); it != end; ++it) {
+        if (it->is_valid_for(target)) {
+            keep.insert(&it->get_reference(target));
+        }
+    }
+
+    expand_except(target, keep);
+}
+
+void IO::parse_tape(std::vector<uint64_t>& words, std::vector<char>& strings, const char *spec, size_t size) {
+    json_config config;
+    memset(&config, 0, sizeof(config));
+    config.max_nesting = 1024;
+    config.max_data = 1 << 27;
+    config.allow_c_comments = 1;
+
+    words.clear();
+    strings.clear();
+
+    uint32_t line = 0, column = 0;
+    tape_context context(words, strings);
+    json_parser parser;
+    int err_code = json_parser_init(&parser, &config, &tape_context::callback, &context);
+    if (err_code == 0) {
+        err_code = run_parser(parser, spec, size, line, column);
+    }
+    json_parser_free(&parser);
+
+    if (context.too_large) {
+        throw std::length_error("Container too large for a tape");
+    }
+    if (err_code != 0) {
+        throw parse_error(error2string(err_code), line, column);
+    }
+
+    // the document keeps exactly one allocation for each buffer
+    std::vector<uint64_t>(words).swap(words);
+    std::vector<char>(strings).swap(strings);
+}
+
+void IO::parse_cbor(Value& target, const uint8_t *data, size_t size) {
+    IO::parser_context context(target);
+    cbor_reader(data, size).read(context);
+}
+
+void IO::print_cbor(const Value& obj, std::vector<uint8_t>& out) {
+    cbor_writer(out).write(obj);
+}
+
+void IO::expand(Value& obj) {
+    raw_text text = obj.raw_; // keeps the buffer alive
+    obj.raw_ = raw_text();
+
+    if (text.kind() == raw_text::packed_int || text.kind() == raw_text::packed_double) {
+        Value::array_type& array = obj.value_.arr_val.write();
+        array.reserve(text.count());
+        for (size_t i = 0, count = text.count(); i < count; ++i) {
+            if (text.kind() == raw_text::packed_int) {
+                array.push_back(Value(text.values<int64_t>()[i]));
+            } else {
+                array.push_back(Value(text.values<double>()[i]));
+            }
+        }
+        return;
+    }
+
+    if (text.kind() == raw_text::column_table) {
+        const columns& table = text.table();
+        Value::array_type& array = obj.value_.arr_val.write();
+        array.resize(table.rows);
+        for (size_t row = 0; row < table.rows; ++row) {
+            Value::map_type& map = array[row].value_.map_val.write();
+            for (std::vector<columns::column>::const_iterator col = table.cols.begin(), end = table.cols.end(); col != end; ++col) {
+                map.insert(map.end(), std::make_pair(col->key, col->at(row))); // already sorted
+            }
+        }
+        return;
+    }
+
+    const char *it = text.data(), *end = it + text.size();
+    bool is_object = *it == '{';
+
+    std::string key;
+    for (it = skip_blank(it + 1, end); *it != '}' && *it != ']'; ) {
+        Value *child;
+        if (is_object) {
+            it = decode_string(it, key);
+            it = skip_blank(skip_blank(it, end) + 1, end); // colon
+            child = &obj.value_.map_val.write()[key];
+        } else {
+            Value::array_type& array = obj.value_.arr_val.write();
+            array.push_back(Value());
+            child = &array.back();
+        }
+
+        const char *value_end = skip_value(it, end);
+        decode_value(*child, text, it, value_end);
+
+        it = skip_blank(value_end, end);
+        if (*it == ',') {
+            it = skip_blank(it + 1, end);
+        }
+    }
+}
+
+void IO::expand_except(Value& obj, const std::set<const Value*>& keep) {
+    if (keep.find(&obj) != keep.end()) {
+        return;
+    }
+
+    obj.expand();
+    if (obj.type_ == Type::Object) {
+        Value::map_type& map = obj.value_.map_val.write();
+        for (Value::iterator it = map.begin(), end = map.end(); it != end; ++it) {
+            expand_except(it->second, keep);
+        }
+    } else if (obj.type_ == Type::Array) {
+        Value::array_type& array = obj.value_.arr_val.write();
+        for (Value::array_iterator it = array.begin(), end = array.end(); it != end; ++it) {
+            expand_except(*it, keep);
+        }
+    }
+}
+
+void IO::decode_value(Value& obj, const raw_text& text, const char *begin, const char *end) {
+    switch (*begin) {
+        case '{':
+            obj = Value();
+            obj.raw_ = text.slice(begin, static_cast<size_t>(end - begin));
+            break;
+        case '[':
+            obj = Value::array_type();
+            obj.raw_ = text.slice(begin, static_cast<size_t>(end - begin));
+            break;
+        case '"':
+            obj = Value();
+            obj.type_ = Type::String;
+            decode_string(begin, obj.value_.str_val);
+            break;
+        case 't':
+            obj = true;
+            break;
+        case 'f':
+            obj = false;
+            break;
+        case 'n':
+            obj = Value::Null;
+            break;
+        default: {
+            std::string number(begin, end);
+            if (number.find_first_of(".eE") == std::string::npos) {
+                obj = detail::stoi64(number);
+            } else {
+                obj = detail::stod(number);
+            }
+            break;
+        }
+    }
+}
+
+void IO::parse_file(Value& target, const std::string& path, bool pack) {
+    mapped_file file;
+    if (file.open(path, mapped_file::sequential)) {
+        return parse(target, file.data(), file.size(), pack);
+    }
+
+    // empty files, pipes and the like are read as a stream
+    std::ifstream stream(path.c_str(), std::ios::in | std::ios::binary);
+    if (!stream) {
+        throw parse_error(std::string("Unable to open file '") + path + "'");
+    }
+    parse(target, stream, pack);
+}
+
+void IO::parse_parallel(Value& target, const char *spec, size_t size, unsigned int threads) {
+#if JSON_HAVE_CXX11
+    static const size_t min_chunk_size = 4096;
+
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    std::vector<size_t> bounds;
+    size_t workers = std::min<size_t>(threads, size / min_chunk_size);
+    if (workers < 2 || !scan_array(spec, size, bounds) || bounds.size() < 3) {
+        return parse(target, spec, size, false);
+    }
+
+    // split at the commas closest to evenly sized chunks
+    std::vector<parallel_chunk> chunks;
+    chunks.reserve(workers);
+    std::vector<size_t>::const_iterator first = bounds.begin(), close = bounds.end() - 1;
+    for (size_t w = 1; first != close; ++w) {
+        std::vector<size_t>::const_iterator last = close;
+        if (w < workers) {
+            size_t offset = bounds.front() + (bounds.back() - bounds.front()) / workers * w;
+            last = std::max(std::lower_bound(first + 1, close, offset), first + 1);
+        }
+        chunks.push_back(parallel_chunk(spec + *first + 1, *last - *first - 1));
+        first = last;
+    }
+
+    std::vector<std::thread> pool;
+    pool.reserve(chunks.size() - 1);
+    try {
+        for (size_t c = 1; c < chunks.size(); ++c) {
+            pool.push_back(std::thread(std::ref(chunks[c])));
+        }
+    } catch (const std::system_error&) {
+        // out of threads, the ones started must be joined before the pool is destroyed
+        for (size_t t = 0; t < pool.size(); ++t) {
+            pool[t].join();
+        }
+        return parse(target, spec, size, false);
+    }
+    chunks[0]();
+    for (size_t t = 0; t < pool.size(); ++t) {
+        pool[t].join();
+    }
+
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        if (!chunks[c].ok) {
+            // slow path, but positions are exact
+            return parse(target, spec, size, false);
+        }
+    }
+
+    // stitch the partial arrays in order
+    Value::array_type& array = chunks[0].result.value_.arr_val.write();
+    size_t total = 0;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        total += chunks[c].result.value_.arr_val->size();
+    }
+    array.reserve(total);
+    for (size_t c = 1; c < chunks.size(); ++c) {
+        Value::array_type& part = chunks[c].result.value_.arr_val.write();
+        array.insert(array.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+    }
+    target = std::move(chunks[0].result);
+#else
+    (void)threads;
+    parse(target, spec, size, false);
+#endif
+}
+
 std::ostream& IO::print(const Value& obj, std::ostream& stream, bool pretty) {
     writer_context context(obj);
     context.print(stream, pretty);
@@ -343,4 +1516,36 @@ std::ostream& IO::print(const Value& obj, std::ostream& stream, bool pretty) {
 }
 
 } // namespace detail
+
+/**********/
+/* Parser */
+/**********/
+
+class Parser::context: public detail::IO::parser_context {
+};
+
+Parser::Parser()
+    : context_(new context()) {
+}
+
+Parser::~Parser() {
+    delete context_;
+}
+
+Value Parser::parse(const char *spec, size_t size) {
+    Value val;
+    detail::IO::parse(*context_, val, spec, size);
+    return val;
+}
+
+Value Parser::parse(const std::string& spec) {
+    return parse(spec.data(), spec.size());
+}
+
+Value Parser::parse(std::istream& stream) {
+    Value val;
+    detail::IO::parse(*context_, val, stream);
+    return val;
+}
+
 } // namespace json
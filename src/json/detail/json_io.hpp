@@ -10,8 +10,10 @@
 #ifndef JSON_DETAIL_JSON_IO_HPP
 #define JSON_DETAIL_JSON_IO_HPP
 
+#include <set>
 #include <string>
 #include <sstream>
+#include <vector>
 
 #include "json/value.hpp"
 
@@ -21,21 +23,95 @@ namespace detail {
 
 class IO {
 public:
+    /* parser state, reusable across documents (see json::Parser) */
+    class parser_context;
+
     /* parses the string `spec`, throws parse_error */
     static void parse(Value& target,
                       const std::string& spec);
 
-    /* parses the content of the input stream `stream`, throws parse_error */
+    /* parses the character string `spec`, packing the large arrays if `pack`, throws parse_error */
     static void parse(Value& target,
+                      const char *spec,
+                      size_t size,
+                      bool pack);
+
+    /* parses the content of the input stream `stream`, packing the large arrays if `pack`, throws parse_error */
+    static void parse(Value& target,
+                      std::istream& stream,
+                      bool pack);
+
+    /* parses the character string `spec` reusing `context`, throws parse_error */
+    static void parse(parser_context& context,
+                      Value& target,
+                      const char *spec,
+                      size_t size);
+
+    /* parses the content of the input stream `stream` reusing `context`, throws parse_error */
+    static void parse(parser_context& context,
+                      Value& target,
                       std::istream& stream);
 
+    /* parses the content of the file at `path`, mapping it into memory when possible, throws parse_error */
+    static void parse_file(Value& target,
+                           const std::string& path,
+                           bool pack);
+
+    /* parses the top-level array in `spec` using up to `threads` workers, throws parse_error */
+    static void parse_parallel(Value& target,
+                               const char *spec,
+                               size_t size,
+                               unsigned int threads);
+
+    /* checks the syntax of `spec` and makes `target` a lazy value, throws parse_error */
+    static void parse_lazy(Value& target,
+                           const char *spec,
+                           size_t size);
+
+    /* parses `spec` keeping the subtrees pointed to by `raw` as text, throws parse_error */
+    static void parse_raw(Value& target,
+                          const char *spec,
+                          size_t size,
+                          const std::vector<Pointer>& raw);
+
+    /* parses `spec` into a tape of words and its string buffer (see tape_format.hpp), throws parse_error */
+    static void parse_tape(std::vector<uint64_t>& words,
+                           std::vector<char>& strings,
+                           const char *spec,
+                           size_t size);
+
+    /* decodes the CBOR (RFC 8949) data item in `data`, throws parse_error */
+    static void parse_cbor(Value& target,
+                           const uint8_t *data,
+                           size_t size);
+
+    /* appends the CBOR (RFC 8949) encoding of `obj` to `out` */
+    static void print_cbor(const Value& obj,
+                           std::vector<uint8_t>& out);
+
+    /* decodes the children of the lazy object or array `obj`, or creates the packed ones */
+    static void expand(Value& obj);
+
     /* dumps the json into the output stream `stream` */
     static std::ostream& print(const Value& obj,
                                std::ostream& stream,
                                bool pretty);
 private:
-    class parser_context;
     class writer_context;
+    class parallel_chunk;
+    class tape_context;
+    class cbor_reader;
+    class cbor_writer;
+
+    /* decodes the (valid) JSON value in [begin, end), objects and arrays are left lazy */
+    static void decode_value(Value& obj,
+                             const raw_text& text,
+                             const char *begin,
+                             const char *end);
+
+    /* decodes the whole tree `obj` except the nodes in `keep` */
+    static void expand_except(Value& obj,
+                              const std::set<const Value*>& keep);
 };
 
 } // namespace detail
@@ -716,6 +716,24 @@ int json_parser_free(json_parser *parser)
     return 0;
 }
 
+/** json_parser_reset reset the parser state to parse a new document, keeping
+ * the memory allocated for the state stack and the parse buffer */
+int json_parser_reset(json_parser *parser)
+{
+    if (!parser->stack || !parser->buffer)
+        return JSON_ERROR_NO_MEMORY;
+
+    parser->state = STATE_GO;
+    parser->save_state = 0;
+    parser->expecting_key = 0;
+    parser->utf8_multibyte_left = 0;
+    parser->unicode_multi = 0;
+    parser->type = JSON_NONE;
+    parser->stack_offset = 0;
+    parser->buffer_offset = 0;
+    return 0;
+}
+
 /** json_parser_is_done return 0 is the parser isn't in a finish state. !0 if it is */
 int json_parser_is_done(json_parser *parser)
 {
@@ -143,6 +143,11 @@ int json_parser_init(json_parser *parser, json_config *cfg,
 /** json_parser_free freed memory structure allocated by the parser */
 int json_parser_free(json_parser *parser);
 
+/** json_parser_reset reset the parser state to parse a new document, keeping
+ * the memory allocated for the state stack and the parse buffer.
+ * return JSON_ERROR_NO_MEMORY if the parser was not initialized or SUCCESS. */
+int json_parser_reset(json_parser *parser);
+
 /** json_parser_string append a string s with a specific length to the parser
  * return 0 if everything went ok, a JSON_ERROR_* otherwise.
  * the user can supplied a valid processed pointer that will
@@ -0,0 +1,38 @@
+/*!
+ * \file lookup_cache.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * json_object Version 2 - Indexes for <key>=<value> lookups and memoized hashes
+ */
+
+#include "json/detail/lookup_cache.hpp"
+
+namespace json {
+namespace detail {
+
+const lookup_cache::index_type *lookup_cache::find(const std::string& key) const {
+    if (table_ == nullptr) {
+        return nullptr;
+    }
+    table_type::const_iterator it = table_->find(key);
+    return it != table_->end() ? &it->second : nullptr;
+}
+
+lookup_cache::index_type& lookup_cache::create(const std::string& key) {
+    if (table_ == nullptr) {
+        table_ = new table_type();
+    }
+    index_type& index = (*table_)[key];
+    index.clear();
+    return index;
+}
+
+void lookup_cache::destroy() {
+    delete table_;
+    table_ = nullptr;
+}
+
+} // namespace detail
+} // namespace json
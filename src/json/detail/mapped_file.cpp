@@ -0,0 +1,72 @@
+/*!
+ * \file mapped_file.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * json_object Version 2 - Read-only files mapped into memory
+ */
+
+#include "mapped_file.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JSON_HAVE_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace json {
+namespace detail {
+
+mapped_file::mapped_file()
+    : data_(nullptr),
+      size_(0) {
+}
+
+mapped_file::~mapped_file() {
+#if JSON_HAVE_MMAP
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+}
+
+bool mapped_file::open(const std::string& path, access hint) {
+#if JSON_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    void *data = MAP_FAILED;
+    size_t size = 0;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        size = static_cast<size_t>(st.st_size);
+        if (size > 0) {
+            data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+    }
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    if (hint == sequential) {
+        madvise(data, size, MADV_SEQUENTIAL);
+    }
+    data_ = static_cast<const char*>(data);
+    size_ = size;
+    return true;
+#else
+    (void)path;
+    (void)hint;
+    return false;
+#endif
+}
+
+} // namespace detail
+} // namespace json
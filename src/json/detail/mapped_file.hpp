@@ -0,0 +1,64 @@
+/*!
+ * \file mapped_file.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * json_object Version 2 - Read-only files mapped into memory
+ */
+
+#ifndef JSON_DETAIL_MAPPED_FILE_HPP
+#define JSON_DETAIL_MAPPED_FILE_HPP
+
+#include "json/detail/compiler.hpp"
+
+#include <string>
+
+namespace json {
+namespace detail {
+
+/**
+ * @brief The content of a regular file mapped into memory (read-only), unmapped along
+ * with the object.
+ */
+class mapped_file {
+public:
+    /* access hints given to the kernel */
+    enum access {
+        sequential, /* read once from start to end */
+        normal      /* read here and there, with the default read-ahead */
+    };
+
+    mapped_file();
+
+    ~mapped_file();
+
+    /**
+     * @brief Maps the file at @p path.
+     *
+     * @return @c false if the file cannot be opened or mapped: empty files, pipes and
+     * the like, or platforms having no @c mmap. The caller is expected to read it instead.
+     */
+    bool open(const std::string& path, access hint);
+
+    const char *data() const {
+        return data_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+private:
+    const char *data_;
+    size_t      size_;
+
+    /* non-copyable */
+    mapped_file(const mapped_file&);
+    mapped_file& operator=(const mapped_file&);
+};
+
+} // namespace detail
+} // namespace json
+
+#endif // JSON_DETAIL_MAPPED_FILE_HPP
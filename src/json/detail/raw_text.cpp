@@ -0,0 +1,142 @@
+/*!
+ * \file raw_text.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * json_object Version 2 - Shared pieces of JSON text
+ */
+
+#include "json/detail/raw_text.hpp"
+
+#include "json/detail/columns.hpp"
+#include "json/detail/ref_count.hpp"
+
+namespace json {
+namespace detail {
+
+struct raw_text::buffer {
+    ref_count            refs;
+    content              kind;
+    std::string          text;
+    std::vector<int64_t> ints;
+    std::vector<double>  dbls;
+    columns             *table;
+
+    buffer(const char *data, size_t size)
+        : kind(json_text),
+          text(data, size),
+          table(nullptr) {
+    }
+
+    explicit buffer(std::vector<int64_t>& values)
+        : kind(packed_int),
+          table(nullptr) {
+        ints.swap(values);
+    }
+
+    explicit buffer(std::vector<double>& values)
+        : kind(packed_double),
+          table(nullptr) {
+        dbls.swap(values);
+    }
+
+    explicit buffer(columns *table)
+        : kind(column_table),
+          table(table) {
+    }
+
+    ~buffer() {
+        delete table;
+    }
+
+    void acquire() {
+        refs.acquire();
+    }
+
+    void release() {
+        if (refs.release()) {
+            delete this;
+        }
+    }
+};
+
+raw_text::raw_text()
+    : buffer_(nullptr),
+      data_(nullptr),
+      size_(0) {
+}
+
+raw_text::raw_text(const char *data, size_t size)
+    : buffer_(new buffer(data, size)),
+      data_(buffer_->text.data()),
+      size_(size) {
+}
+
+raw_text::raw_text(std::vector<int64_t>& values)
+    : buffer_(new buffer(values)),
+      data_(buffer_->ints.empty() ? nullptr : &buffer_->ints[0]),
+      size_(buffer_->ints.size()) {
+}
+
+raw_text::raw_text(std::vector<double>& values)
+    : buffer_(new buffer(values)),
+      data_(buffer_->dbls.empty() ? nullptr : &buffer_->dbls[0]),
+      size_(buffer_->dbls.size()) {
+}
+
+raw_text::raw_text(columns *table)
+    : buffer_(new buffer(table)),
+      data_(nullptr),
+      size_(0) {
+}
+
+raw_text::raw_text(buffer *buf, const char *data, size_t size)
+    : buffer_(buf),
+      data_(data),
+      size_(size) {
+    buffer_->acquire();
+}
+
+raw_text::raw_text(const raw_text& other)
+    : buffer_(other.buffer_),
+      data_(other.data_),
+      size_(other.size_) {
+    if (buffer_) {
+        buffer_->acquire();
+    }
+}
+
+raw_text::~raw_text() {
+    if (buffer_) {
+        buffer_->release();
+    }
+}
+
+raw_text& raw_text::operator=(const raw_text& other) {
+    if (other.buffer_) {
+        other.buffer_->acquire();
+    }
+    if (buffer_) {
+        buffer_->release();
+    }
+    buffer_ = other.buffer_;
+    data_ = other.data_;
+    size_ = other.size_;
+    return *this;
+}
+
+raw_text::content raw_text::kind() const {
+    return buffer_ != nullptr ? buffer_->kind : json_text;
+}
+
+const columns& raw_text::table() const {
+    return *buffer_->table;
+}
+
+raw_text raw_text::slice(const char *begin, size_t size) const {
+    return raw_text(buffer_, begin, size);
+}
+
+} // namespace detail
+} // namespace json
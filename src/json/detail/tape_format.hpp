@@ -0,0 +1,261 @@
+/*!
+ * \file tape_format.hpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ *
+ * json_object Version 2 - Words of a tape document
+ */
+
+#ifndef JSON_DETAIL_TAPE_FORMAT_HPP
+#define JSON_DETAIL_TAPE_FORMAT_HPP
+
+#include "json/detail/compiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace json {
+namespace detail {
+namespace tape {
+
+/*
+ * Each word has a tag in its high 8 bits and a payload in the low 56 bits:
+ *
+ *   null, true, false   one word, no payload
+ *   small integer       one word, the integer in the payload (56 bits, two's complement)
+ *   integer, double     the tag word, then a word holding the raw 64 bits
+ *   string, key         the offset of the string in the string buffer, where it is
+ *                       stored as a 32-bit length, the bytes and a null character
+ *   object, array       the distance to the word past the closing word (low 32 bits)
+ *                       and the number of children, saturated (high 24 bits)
+ *   closing words       the distance back to the opening word
+ *
+ * The members of an object are a key word followed by the words of the value.
+ */
+enum tag {
+    null_tag     = 'n',
+    true_tag     = 't',
+    false_tag    = 'f',
+    small_tag    = 'i',
+    int_tag      = 'l',
+    double_tag   = 'd',
+    string_tag   = '"',
+    object_tag   = '{',
+    object_end   = '}',
+    array_tag    = '[',
+    array_end    = ']'
+};
+
+static const uint64_t payload_mask = (static_cast<uint64_t>(1) << 56) - 1;
+static const uint64_t max_skip     = 0xffffffffu;
+static const uint64_t max_count    = 0xffffffu; /* the count of bigger containers is computed */
+
+inline uint64_t make_word(tag t, uint64_t payload) {
+    return (static_cast<uint64_t>(t) << 56) | payload;
+}
+
+/* the integers that fit in a payload */
+inline bool is_small(int64_t value) {
+    static const int64_t limit = static_cast<int64_t>(1) << 55;
+    return value >= -limit && value < limit;
+}
+
+inline int64_t small_of(uint64_t word) {
+    return static_cast<int64_t>(word << 8) >> 8; // sign-extended
+}
+
+inline tag tag_of(uint64_t word) {
+    return static_cast<tag>(word >> 56);
+}
+
+inline uint64_t payload_of(uint64_t word) {
+    return word & payload_mask;
+}
+
+/* the number of words taken by the value starting with `word` */
+inline uint64_t width_of(uint64_t word) {
+    switch (tag_of(word)) {
+        case int_tag:
+        case double_tag:
+            return 2;
+        case object_tag:
+        case array_tag:
+            return word & max_skip;
+        default:
+            return 1;
+    }
+}
+
+inline uint64_t count_of(uint64_t word) {
+    return payload_of(word) >> 32;
+}
+
+inline uint32_t string_size(const char *strings, uint64_t word) {
+    uint32_t size;
+    std::memcpy(&size, strings + payload_of(word), sizeof(size));
+    return size;
+}
+
+inline const char *string_data(const char *strings, uint64_t word) {
+    return strings + payload_of(word) + sizeof(uint32_t);
+}
+
+/**
+ * @brief Appends the words of a tape, the values are given in document order.
+ *
+ * Keys can be interned, each distinct key is then stored once in the string buffer.
+ * It takes a lookup per key, worth it for tapes written once and read many times.
+ */
+class writer {
+public:
+    writer(std::vector<uint64_t>& words, std::vector<char>& strings, bool intern_keys)
+        : words_(words),
+          strings_(strings),
+          intern_keys_(intern_keys) {
+        open_.reserve(32);
+        counts_.reserve(32);
+    }
+
+    /* null, true or false */
+    void literal(tag t) {
+        count();
+        words_.push_back(make_word(t, 0));
+    }
+
+    void integer(int64_t value) {
+        if (is_small(value)) {
+            count();
+            words_.push_back(make_word(small_tag, static_cast<uint64_t>(value) & payload_mask));
+        } else {
+            number(int_tag, value);
+        }
+    }
+
+    void real(double value) {
+        number(double_tag, value);
+    }
+
+    void string(const char *data, size_t size) {
+        count();
+        push_string(data, size);
+    }
+
+    void key(const char *data, size_t size) {
+        ++counts_.back(); // members are counted by their keys
+        if (!intern_keys_) {
+            push_string(data, size);
+            return;
+        }
+
+        std::pair<std::map<std::string, uint64_t>::iterator, bool> entry
+                = keys_.insert(std::make_pair(std::string(data, size), static_cast<uint64_t>(strings_.size())));
+        if (entry.second) {
+            push_string(data, size);
+        } else {
+            words_.push_back(make_word(string_tag, entry.first->second));
+        }
+    }
+
+    void open(tag t) {
+        count();
+        open_.push_back(words_.size());
+        counts_.push_back(0);
+        words_.push_back(make_word(t, 0)); // patched when closed
+    }
+
+    /* `false` if the container is too big for a tape */
+    bool close(tag t) {
+        size_t start = open_.back();
+        uint64_t skip = words_.size() + 1 - start;
+        if (skip > max_skip) {
+            return false;
+        }
+
+        uint64_t count = std::min(counts_.back(), max_count);
+        words_[start] |= (count << 32) | skip;
+        words_.push_back(make_word(t, skip - 1));
+
+        open_.pop_back();
+        counts_.pop_back();
+        return true;
+    }
+
+private:
+    std::vector<uint64_t>& words_;
+    std::vector<char>&     strings_;
+    std::vector<size_t>    open_;   /* the opening words of the objects and arrays being written */
+    std::vector<uint64_t>  counts_; /* the number of children of each of them so far */
+    bool                   intern_keys_;
+    std::map<std::string, uint64_t> keys_; /* the offsets of the interned keys */
+
+    template <typename T> void number(tag t, T value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        count();
+        words_.push_back(make_word(t, 0));
+        words_.push_back(bits);
+    }
+
+    /* counts the element of an array */
+    void count() {
+        if (!open_.empty() && tag_of(words_[open_.back()]) == array_tag) {
+            ++counts_.back();
+        }
+    }
+
+    void push_string(const char *data, size_t size) {
+        if (size > static_cast<uint32_t>(-1)) {
+            throw std::length_error("String too long for a tape");
+        }
+        uint32_t length = static_cast<uint32_t>(size);
+        words_.push_back(make_word(string_tag, strings_.size()));
+        strings_.insert(strings_.end(), reinterpret_cast<const char*>(&length), reinterpret_cast<const char*>(&length) + sizeof(length));
+        strings_.insert(strings_.end(), data, data + size);
+        strings_.push_back('\0');
+    }
+};
+
+/*
+ * A snapshot file is the header followed by the words of the tape and the string buffer,
+ * all of it in the byte order of the machine that wrote it.
+ */
+struct snapshot_header {
+    char     magic[8];   /* "JSONTAPE" */
+    uint32_t version;    /* of the layout */
+    uint32_t byte_order; /* byte_order_mark, as written */
+    uint64_t words;      /* the number of words of the tape */
+    uint64_t strings;    /* the size of the string buffer */
+    uint64_t checksum;   /* of the header (having this field zeroed) and the content */
+};
+
+static const char     snapshot_magic[8] = { 'J', 'S', 'O', 'N', 'T', 'A', 'P', 'E' };
+static const uint32_t snapshot_version  = 1;
+static const uint32_t byte_order_mark   = 0x01020304;
+
+/* continues the checksum `hash` over `size` bytes at `data`, eight at a time */
+inline uint64_t checksum(uint64_t hash, const char *data, size_t size) {
+    for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        hash = (hash ^ word) * 0x100000001b3ULL;
+        hash ^= hash >> 32;
+    }
+    if (size > 0) {
+        uint64_t word = 0;
+        std::memcpy(&word, data, size);
+        hash = (hash ^ word) * 0x100000001b3ULL;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+} // namespace tape
+} // namespace detail
+} // namespace json
+
+#endif // JSON_DETAIL_TAPE_FORMAT_HPP
@@ -64,4 +64,22 @@ unsigned int parse_error::column() const {
     return column_;
 }
 
+/* patch_error */
+
+patch_error::patch_error(const std::string& msg)
+    : error_base(std::string("Patch error: ") + msg) {
+}
+
+patch_error::~patch_error() noexcept {
+}
+
+/* snapshot_error */
+
+snapshot_error::snapshot_error(const std::string& msg)
+    : error_base(std::string("Snapshot error: ") + msg) {
+}
+
+snapshot_error::~snapshot_error() noexcept {
+}
+
 } // namespace json
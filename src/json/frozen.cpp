@@ -0,0 +1,459 @@
+/*!
+ * \file frozen.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include "json/frozen.hpp"
+
+#include "json/detail/ref_count.hpp"
+#include "json/errors.hpp"
+#include "json/value.hpp"
+
+#include <cstring>
+#include <map>
+#include <vector>
+
+#define TYPE_VALID_OR_THROW(type) do { \
+    if (!((type) & type_)) { \
+        throw bad_json_type(static_cast<Type::Value>(type), type_); \
+    } \
+} while (false)
+
+namespace json {
+
+/* `lhs` and `rhs` compared as std::string::compare does */
+static int compare_keys(const char *lhs, size_t lhs_size, const char *rhs, size_t rhs_size) {
+    int result = memcmp(lhs, rhs, lhs_size < rhs_size ? lhs_size : rhs_size);
+    if (result != 0) {
+        return result;
+    }
+    return lhs_size < rhs_size ? -1 : (lhs_size > rhs_size ? 1 : 0);
+}
+
+/****************/
+/* frozen value */
+/****************/
+
+FrozenValue::FrozenValue()
+    : type_(Type::Null),
+      key_size_(0),
+      key_(nullptr),
+      size_(0) {
+    value_.int_val = 0;
+}
+
+Type::Value FrozenValue::type() const {
+    return type_;
+}
+
+bool FrozenValue::empty() const {
+    return (type_ & (Type::Object|Type::Array)) && size_ == 0;
+}
+
+size_t FrozenValue::size() const {
+    TYPE_VALID_OR_THROW(Type::Object|Type::Array);
+    return size_;
+}
+
+std::string FrozenValue::key() const {
+    return key_ != nullptr ? std::string(key_, key_size_) : std::string();
+}
+
+bool FrozenValue::exists(const std::string& key) const {
+    return find(key) != nullptr;
+}
+
+bool FrozenValue::to_bool() const {
+    TYPE_VALID_OR_THROW(Type::Boolean);
+    return value_.bool_val;
+}
+
+int64_t FrozenValue::to_int() const {
+    TYPE_VALID_OR_THROW(Type::Integer);
+    return value_.int_val;
+}
+
+double FrozenValue::to_double() const {
+    TYPE_VALID_OR_THROW(Type::Double|Type::Integer);
+    if (type_ == Type::Integer) {
+        return static_cast<double>(value_.int_val);
+    }
+    return value_.dbl_val;
+}
+
+std::string FrozenValue::to_string() const {
+    TYPE_VALID_OR_THROW(Type::String);
+    return std::string(value_.str_val, size_);
+}
+
+const char *FrozenValue::c_str() const {
+    TYPE_VALID_OR_THROW(Type::String);
+    return value_.str_val;
+}
+
+const FrozenValue& FrozenValue::operator[](const std::string& key) const {
+    if (type_ != Type::Object && !(type_ == Type::Array && size_ == 0)) { // like Value, accept empty arrays
+        throw bad_json_type(Type::Object, type_);
+    }
+    const FrozenValue *member = find(key);
+    if (member == nullptr) {
+        throw key_not_found(key);
+    }
+    return *member;
+}
+
+const FrozenValue& FrozenValue::operator[](size_t idx) const {
+    TYPE_VALID_OR_THROW(Type::Array);
+    if (idx >= size_) {
+        throw std::out_of_range("Index " + detail::to_string(static_cast<uint64_t>(idx)) + " is out of range");
+    }
+    return value_.children[idx];
+}
+
+const FrozenValue& FrozenValue::operator[](const Pointer& pointer) const {
+    const FrozenValue *obj = this;
+    for (std::vector<Pointer::token>::const_iterator it = pointer.tokens_.begin(), end = pointer.tokens_.end();
+            it != end;
+            ++it) {
+        if ((obj = step(obj, *it)) == nullptr) {
+            throw key_not_found(it->key);
+        }
+    }
+    return *obj;
+}
+
+const FrozenValue *FrozenValue::find(const std::string& key) const {
+    if (type_ != Type::Object) {
+        return nullptr;
+    }
+
+    // members are sorted by key
+    const FrozenValue *first = value_.children, *last = value_.children + size_;
+    while (first < last) {
+        const FrozenValue *middle = first + (last - first) / 2;
+        int result = compare_keys(middle->key_, middle->key_size_, key.data(), key.size());
+        if (result == 0) {
+            return middle;
+        }
+        if (result < 0) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return nullptr;
+}
+
+const FrozenValue *FrozenValue::find(const Pointer& pointer) const {
+    const FrozenValue *obj = this;
+    for (std::vector<Pointer::token>::const_iterator it = pointer.tokens_.begin(), end = pointer.tokens_.end();
+            it != end && obj != nullptr;
+            ++it) {
+        obj = step(obj, *it);
+    }
+    return obj;
+}
+
+const FrozenValue *FrozenValue::begin() const {
+    TYPE_VALID_OR_THROW(Type::Object|Type::Array);
+    return value_.children;
+}
+
+const FrozenValue *FrozenValue::end() const {
+    TYPE_VALID_OR_THROW(Type::Object|Type::Array);
+    return value_.children + size_;
+}
+
+Value FrozenValue::thaw() const {
+    switch (type_) {
+        case Type::Null:
+            return Value::Null;
+        case Type::Boolean:
+            return Value(value_.bool_val);
+        case Type::Integer:
+            return Value(value_.int_val);
+        case Type::Double:
+            return Value(value_.dbl_val);
+        case Type::String:
+            return Value(std::string(value_.str_val, size_));
+        case Type::Array: {
+            Value::array_type array;
+            array.reserve(size_);
+            for (const FrozenValue *it = begin(), *end = this->end(); it != end; ++it) {
+                array.push_back(it->thaw());
+            }
+            return Value(array);
+        }
+        default: {
+            Value::map_type map;
+            for (const FrozenValue *it = begin(), *end = this->end(); it != end; ++it) {
+                map.insert(map.end(), std::make_pair(it->key(), it->thaw())); // already sorted
+            }
+            return Value(map);
+        }
+    }
+}
+
+std::string FrozenValue::stringify(bool pretty) const {
+    return thaw().stringify(pretty);
+}
+
+const FrozenValue *FrozenValue::step(const FrozenValue *obj, const Pointer::token& tok) {
+    switch (obj->type_) {
+        case Type::Object: {
+            const FrozenValue *member = obj->find(tok.key);
+            if (member == nullptr && tok.has_filter) { // try <key>=<value> scheme
+                key_hint hint;
+                for (const FrozenValue *it = obj->value_.children, *end = it + obj->size_; it != end; ++it) {
+                    if (is_a_match(*it, tok, hint)) {
+                        return it;
+                    }
+                }
+            }
+            return member;
+        }
+        case Type::Array: {
+            if (tok.bad_index) {
+                throw parse_error(std::string("Reference token '") + tok.key  + "' is invalid in this context");
+            }
+            if (tok.has_filter) {
+                key_hint hint;
+                for (const FrozenValue *it = obj->value_.children, *end = it + obj->size_; it != end; ++it) {
+                    if (is_a_match(*it, tok, hint)) {
+                        return it;
+                    }
+                }
+            }
+            if (!tok.has_index) {
+                throw parse_error(std::string("Reference token '") + tok.key  + "' is not a number");
+            }
+            if (tok.index >= obj->size_) {
+                return nullptr;
+            }
+            return &obj->value_.children[tok.index];
+        }
+        default:
+            return nullptr;
+    }
+}
+
+bool FrozenValue::is_a_match(const FrozenValue& obj, const Pointer::token& tok, key_hint& hint) {
+    const FrozenValue *member = nullptr;
+    if (hint.key != nullptr && obj.type_ == Type::Object && hint.index < obj.size_
+            && obj.value_.children[hint.index].key_ == hint.key) {
+        // keys are interned, siblings having the same schema have the member at the same position
+        member = &obj.value_.children[hint.index];
+    } else {
+        member = obj.find(tok.filter_key);
+        if (member == nullptr) {
+            return false;
+        }
+        hint.key = member->key_;
+        hint.index = static_cast<size_t>(member - obj.value_.children);
+    }
+
+    const std::string& value = tok.filter_value;
+    switch (member->type_) {
+        case Type::Null:
+            return (value == "null");
+        case Type::Boolean:
+            return member->value_.bool_val ? (value == "true") : (value == "false");
+        case Type::Integer:
+            return tok.has_filter_int && member->value_.int_val == tok.filter_int;
+        case Type::Double:
+            return tok.has_filter_dbl && member->value_.dbl_val == tok.filter_dbl;
+        case Type::String:
+            return compare_keys(member->value_.str_val, member->size_, value.data(), value.size()) == 0;
+        default:
+            return false;
+    }
+}
+
+/*******************/
+/* frozen document */
+/*******************/
+
+struct FrozenDocument::tree {
+    detail::ref_count        refs;
+    std::vector<FrozenValue> nodes; /* in level order, never resized once built */
+    std::vector<char>        pool;  /* strings and keys, null-terminated */
+};
+
+FrozenDocument::FrozenDocument()
+    : tree_(nullptr) {
+}
+
+FrozenDocument::FrozenDocument(const Value& value)
+    : tree_(build(value)) {
+}
+
+FrozenDocument::FrozenDocument(tree *t)
+    : tree_(t) {
+}
+
+FrozenDocument::FrozenDocument(const FrozenDocument& other)
+    : tree_(other.share()) {
+}
+
+FrozenDocument::~FrozenDocument() {
+    release(tree_);
+}
+
+FrozenDocument& FrozenDocument::operator=(const FrozenDocument& other) {
+    tree *shared = other.share();
+    release(tree_);
+    tree_ = shared;
+    return *this;
+}
+
+FrozenDocument::tree *FrozenDocument::share() const {
+    return acquire(tree_);
+}
+
+FrozenDocument::tree *FrozenDocument::acquire(tree *t) {
+    if (t != nullptr) {
+        t->refs.acquire();
+    }
+    return t;
+}
+
+void FrozenDocument::release(tree *t) {
+    if (t != nullptr && t->refs.release()) {
+        delete t;
+    }
+}
+
+const FrozenValue& FrozenDocument::root() const {
+    if (tree_ == nullptr) {
+        static const FrozenValue null_value;
+        return null_value;
+    }
+    return tree_->nodes[0];
+}
+
+size_t FrozenDocument::count() const {
+    return tree_ != nullptr ? tree_->nodes.size() : 1;
+}
+
+size_t FrozenDocument::memory() const {
+    if (tree_ == nullptr) {
+        return 0;
+    }
+    return sizeof(tree) + tree_->nodes.capacity() * sizeof(FrozenValue) + tree_->pool.capacity();
+}
+
+/* interned keys, each distinct key is stored once in the pool */
+typedef std::map<std::string, const char*> key_dictionary;
+
+/* counts the nodes and the bytes of strings in `value`, collects the keys in `keys` */
+static void measure(const Value& value, size_t& nodes, size_t& bytes, key_dictionary& keys) {
+    ++nodes;
+    switch (value.type()) {
+        case Type::String:
+            bytes += value.to_string().size() + 1;
+            break;
+        case Type::Array:
+            for (Value::const_array_iterator it = value.abegin(), end = value.aend(); it != end; ++it) {
+                measure(*it, nodes, bytes, keys);
+            }
+            break;
+        case Type::Object:
+            for (Value::const_iterator it = value.begin(), end = value.end(); it != end; ++it) {
+                if (keys.insert(std::make_pair(it->first, static_cast<const char*>(nullptr))).second) {
+                    bytes += it->first.size() + 1;
+                }
+                measure(it->second, nodes, bytes, keys);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/* copies `str` into the pool */
+static const char *store(const std::string& str, char * & cursor) {
+    char *stored = cursor;
+    memcpy(cursor, str.data(), str.size());
+    cursor[str.size()] = '\0';
+    cursor += str.size() + 1;
+    return stored;
+}
+
+FrozenDocument::tree *FrozenDocument::build(const Value& value) {
+    size_t nodes = 0, bytes = 0;
+    key_dictionary keys;
+    measure(value, nodes, bytes, keys);
+
+    tree *result = new tree();
+    try {
+        result->nodes.resize(nodes, FrozenValue());
+        result->pool.resize(bytes);
+
+        char *cursor = result->pool.empty() ? nullptr : &result->pool[0];
+        for (key_dictionary::iterator it = keys.begin(), end = keys.end(); it != end; ++it) {
+            if (it->first.size() > static_cast<uint32_t>(-1)) {
+                throw std::length_error("Key too long");
+            }
+            it->second = store(it->first, cursor);
+        }
+
+        FrozenValue *next = &result->nodes[0] + 1;
+
+        // level order: the children of each object or array are stored next to each other
+        std::vector<std::pair<const Value*, FrozenValue*> > queue;
+        queue.reserve(nodes);
+        queue.push_back(std::make_pair(&value, &result->nodes[0]));
+        for (size_t i = 0; i < queue.size(); ++i) {
+            const Value& obj = *queue[i].first;
+            FrozenValue& node = *queue[i].second;
+
+            node.type_ = obj.type();
+            switch (node.type_) {
+                case Type::Boolean:
+                    node.value_.bool_val = obj.to_bool();
+                    break;
+                case Type::Integer:
+                    node.value_.int_val = obj.to_int();
+                    break;
+                case Type::Double:
+                    node.value_.dbl_val = obj.to_double();
+                    break;
+                case Type::String:
+                    node.size_ = obj.to_string().size();
+                    node.value_.str_val = store(obj.to_string(), cursor);
+                    break;
+                case Type::Array:
+                    node.size_ = obj.size();
+                    node.value_.children = next;
+                    for (Value::const_array_iterator it = obj.abegin(), end = obj.aend(); it != end; ++it) {
+                        queue.push_back(std::make_pair(&*it, next++));
+                    }
+                    break;
+                case Type::Object:
+                    node.size_ = obj.size();
+                    node.value_.children = next;
+                    for (Value::const_iterator it = obj.begin(), end = obj.end(); it != end; ++it) {
+                        next->key_size_ = static_cast<uint32_t>(it->first.size());
+                        next->key_ = keys.find(it->first)->second;
+                        queue.push_back(std::make_pair(&it->second, next++));
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+    } catch (...) {
+        delete result;
+        throw;
+    }
+
+    return result;
+}
+
+FrozenDocument freeze(const Value& value) {
+    return FrozenDocument(value);
+}
+
+} // namespace json
@@ -0,0 +1,180 @@
+/*!
+ * \file hash.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include "json/hash.hpp"
+#include "json/detail/columns.hpp"
+
+#include <cstring>
+
+namespace json {
+
+const json_spec_memoize option_memoize = {};
+
+namespace detail {
+
+class hasher {
+public:
+    explicit hasher(bool memoize)
+        : memoize_(memoize) {
+    }
+
+    uint64_t operator()(const Value& obj) const {
+        if (obj.temp_flag_.is_temporary) {
+            throw key_not_found(obj.value_.str_val);
+        }
+
+        switch (obj.type_) {
+            case Type::Null:
+                return finish(1);
+            case Type::Boolean:
+                return finish(obj.value_.bool_val ? 2 : 3);
+            case Type::Integer:
+                return number(static_cast<double>(obj.value_.int_val));
+            case Type::Double:
+                return number(obj.value_.dbl_val);
+            case Type::String:
+                return string(5, obj.value_.str_val);
+            default:
+                break;
+        }
+
+        if (memoize_) {
+            if (uint64_t cached = obj.lookups_.hash()) {
+                return cached;
+            }
+        }
+
+        uint64_t result;
+        if (obj.is_packed()) {
+            result = packed(obj);
+        } else {
+            obj.expand();
+            if (obj.type_ == Type::Array) {
+                result = 6;
+                for (Value::const_array_iterator it = obj.value_.arr_val->begin(), end = obj.value_.arr_val->end(); it != end; ++it) {
+                    result = combine(result, (*this)(*it));
+                }
+            } else {
+                // members are sorted by key, the order they were inserted in does not matter
+                result = 7;
+                for (Value::const_iterator it = obj.value_.map_val->begin(), end = obj.value_.map_val->end(); it != end; ++it) {
+                    result = combine(combine(result, string(8, it->first)), (*this)(it->second));
+                }
+            }
+        }
+
+        result = finish(result);
+        result = result != 0 ? result : 1; // 0 means not memoized
+        if (memoize_) {
+            obj.lookups_.hash(result);
+        }
+        return result;
+    }
+
+private:
+    bool memoize_;
+
+    /* murmur3 finalizer */
+    static uint64_t finish(uint64_t hash) {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    static uint64_t combine(uint64_t hash, uint64_t value) {
+        return (hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2))) * 0x100000001b3ULL;
+    }
+
+    /* integers and doubles hash alike, equals() compares them by value */
+    static uint64_t number(double value) {
+        value = value == 0 ? 0.0 : value; // -0.0 == 0.0
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return finish(combine(4, bits));
+    }
+
+    /* as if the elements were created */
+    uint64_t packed(const Value& obj) const {
+        uint64_t result = 6;
+        if (obj.raw_.kind() == raw_text::packed_int) {
+            span<const int64_t> values = obj.to_int_span();
+            for (const int64_t *it = values.begin(); it != values.end(); ++it) {
+                result = combine(result, number(static_cast<double>(*it)));
+            }
+            return result;
+        }
+        if (obj.raw_.kind() == raw_text::packed_double) {
+            span<const double> values = obj.to_double_span();
+            for (const double *it = values.begin(); it != values.end(); ++it) {
+                result = combine(result, number(*it));
+            }
+            return result;
+        }
+
+        const columns& table = obj.raw_.table();
+        for (size_t row = 0; row < table.rows; ++row) {
+            uint64_t member = 7;
+            for (std::vector<columns::column>::const_iterator col = table.cols.begin(), end = table.cols.end(); col != end; ++col) {
+                uint64_t value;
+                switch (col->kind) {
+                    case columns::column::ints:
+                        value = number(static_cast<double>(col->int_vals[row]));
+                        break;
+                    case columns::column::dbls:
+                        value = number(col->dbl_vals[row]);
+                        break;
+                    case columns::column::strings:
+                        value = string(5, col->pool.data() + col->offsets[row], col->offsets[row + 1] - col->offsets[row]);
+                        break;
+                    default:
+                        value = (*this)(col->any_vals[row]);
+                        break;
+                }
+                member = combine(combine(member, string(8, col->key)), value);
+            }
+            member = finish(member);
+            result = combine(result, member != 0 ? member : 1);
+        }
+        return result;
+    }
+
+    static uint64_t string(uint64_t seed, const std::string& value) {
+        return string(seed, value.data(), value.size());
+    }
+
+    /* eight bytes at a time */
+    static uint64_t string(uint64_t seed, const char *data, size_t size) {
+
+        uint64_t hash = combine(seed, size);
+        for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, data, sizeof(word));
+            hash = combine(hash, word);
+        }
+        if (size > 0) {
+            uint64_t word = 0;
+            std::memcpy(&word, data, size);
+            hash = combine(hash, word);
+        }
+        return finish(hash);
+    }
+};
+
+} // namespace detail
+
+uint64_t hash(const Value& value) {
+    return detail::hasher(false)(value);
+}
+
+uint64_t hash(const Value& value, const json_spec_memoize&) {
+    return detail::hasher(true)(value);
+}
+
+} // namespace json
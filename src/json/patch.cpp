@@ -0,0 +1,603 @@
+/*!
+ * \file patch.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include "json/patch.hpp"
+
+#include "json/errors.hpp"
+#include "json/hash.hpp"
+
+#include <map>
+#if JSON_HAVE_CXX11
+#include <unordered_map>
+#endif
+
+#if JSON_HAVE_CXX11
+#define JSON_MOVE(x) std::move(x)
+#else
+#define JSON_MOVE(x) (x)
+#endif
+
+namespace json {
+
+/* `path` without its last reference token */
+static std::string parent_of(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? std::string() : path.substr(0, slash);
+}
+
+/* the last reference token of `path`, unescaped */
+static std::string last_of(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string token = slash == std::string::npos ? std::string() : path.substr(slash + 1);
+    for (size_t pos = token.find('~'); pos != std::string::npos; pos = token.find('~', pos + 1)) {
+        token.replace(pos, 2, token.compare(pos, 2, "~1") == 0 ? "/" : "~");
+    }
+    return token;
+}
+
+/* the reference token for `key` */
+static std::string escape(const std::string& key) {
+    std::string token;
+    for (std::string::const_iterator it = key.begin(), end = key.end(); it != end; ++it) {
+        switch (*it) {
+            case '~':
+                token += "~0";
+                break;
+            case '/':
+                token += "~1";
+                break;
+            default:
+                token += *it;
+        }
+    }
+    return token;
+}
+
+/* RFC-6902 compares values structurally, numbers by their value */
+static bool equals(const Value& lhs, const Value& rhs) {
+    return lhs.equals(rhs, 0);
+}
+
+/* the operation, parsed and compiled */
+
+Patch::operation::operation(kind_type kind, const std::string& path, const std::string& from, const Value& value)
+    : kind(kind),
+      path(path),
+      parent_path(parent_of(path)),
+      last(last_of(path)),
+      from(from),
+      from_parent(parent_of(from)),
+      from_last(last_of(from)),
+      path_ptr(path),
+      parent_ptr(parent_path),
+      from_ptr(from),
+      from_parent_ptr(from_parent),
+      value(value) {
+}
+
+Patch::Patch(const Value& spec) {
+    if (!spec.is_array() && !(spec.is_object() && spec.empty())) {
+        throw parse_error("A JSON patch must be an array of operations");
+    }
+
+    static const char *names[] = { "add", "remove", "replace", "move", "copy", "test" };
+
+    for (size_t i = 0; i < spec.size(); ++i) {
+        const Value& op = spec[i];
+        std::string error = "Invalid patch operation #" + detail::to_string(static_cast<uint64_t>(i)) + ": ";
+        if (!op.is_object() || !op.exists("op") || !op["op"].is_string()) {
+            throw parse_error(error + "'op' is missing");
+        }
+        if (!op.exists("path") || !op["path"].is_string()) {
+            throw parse_error(error + "'path' is missing");
+        }
+
+        size_t kind = 0;
+        while (kind < sizeof(names)/sizeof(names[0]) && op["op"].to_string() != names[kind]) {
+            ++kind;
+        }
+        if (kind == sizeof(names)/sizeof(names[0])) {
+            throw parse_error(error + "unknown operation '" + op["op"].to_string() + "'");
+        }
+
+        std::string from;
+        if (kind == operation::move || kind == operation::copy) {
+            if (!op.exists("from") || !op["from"].is_string()) {
+                throw parse_error(error + "'from' is missing");
+            }
+            from = op["from"].to_string();
+        }
+
+        bool has_value = (kind == operation::add || kind == operation::replace || kind == operation::test);
+        if (has_value && !op.exists("value")) {
+            throw parse_error(error + "'value' is missing");
+        }
+
+        operations_.push_back(operation(static_cast<operation::kind_type>(kind),
+                                        op["path"].to_string(),
+                                        from,
+                                        has_value ? op["value"] : Value::Null));
+    }
+}
+
+size_t Patch::size() const {
+    return operations_.size();
+}
+
+/* applies the operations, keeping what is needed to revert them */
+
+class Patch::context {
+    /* the inverse of an applied operation, with concrete paths (array indices, actual keys) */
+    struct undo_entry {
+        enum action_type { erase, set, insert, move_back, root };
+
+        action_type action;
+        std::string path;
+        std::string from; /* move_back: where the value came from */
+        Value       value;
+
+        undo_entry(action_type action, const std::string& path)
+            : action(action),
+              path(path) {
+        }
+    };
+
+    Value& target_;
+    std::vector<undo_entry> undo_log_;
+
+public:
+    context(Value& target)
+        : target_(target) {
+    }
+
+    void apply(const operation& op) {
+        switch (op.kind) {
+            case operation::add: {
+                Value added(op.value);
+                add(op, added);
+                break;
+            }
+            case operation::remove: {
+                std::string where;
+                Value removed = take(op.path_ptr, op.path, op.parent_ptr, op.parent_path, op.last, where);
+                undo_log_.push_back(undo_entry(undo_entry::insert, where));
+                undo_log_.back().value = JSON_MOVE(removed);
+                break;
+            }
+            case operation::replace: {
+                Value *node = locate(op.path_ptr, op.path);
+                if (node == nullptr) {
+                    throw patch_error("Path '" + op.path + "' does not exist");
+                }
+                if (node == &target_) {
+                    undo_log_.push_back(undo_entry(undo_entry::root, std::string()));
+                } else {
+                    undo_log_.push_back(undo_entry(undo_entry::set,
+                                                   concrete_path(op.parent_ptr, op.parent_path, op.last, node)));
+                }
+                undo_log_.back().value = JSON_MOVE(*node);
+                *node = op.value;
+                break;
+            }
+            case operation::move: {
+                if (op.path.compare(0, op.from.size() + 1, op.from + "/") == 0) {
+                    throw patch_error("Cannot move '" + op.from + "' into one of its children");
+                }
+                if (op.path == op.from) {
+                    if (locate(op.from_ptr, op.from) == nullptr) {
+                        throw patch_error("Path '" + op.from + "' does not exist");
+                    }
+                    break;
+                }
+                if (op.path.empty()) {
+                    // the document is replaced, its undo entry keeps it whole
+                    const Value *node = locate(op.from_ptr, op.from);
+                    if (node == nullptr) {
+                        throw patch_error("Path '" + op.from + "' does not exist");
+                    }
+                    Value moved(*node);
+                    add(op, moved);
+                    break;
+                }
+                std::string from;
+                Value moved = take(op.from_ptr, op.from, op.from_parent_ptr, op.from_parent, op.from_last, from);
+                std::string to;
+                try {
+                    to = add(op, moved);
+                } catch (...) {
+                    // add() checks the destination before changing anything
+                    insert_at(from, moved);
+                    throw;
+                }
+                if (undo_log_.back().action == undo_entry::erase) {
+                    undo_log_.pop_back(); // moving the value back removes it
+                }
+                undo_log_.push_back(undo_entry(undo_entry::move_back, to));
+                undo_log_.back().from = from;
+                break;
+            }
+            case operation::copy: {
+                const Value *node = locate(op.from_ptr, op.from);
+                if (node == nullptr) {
+                    throw patch_error("Path '" + op.from + "' does not exist");
+                }
+                Value copied(*node);
+                add(op, copied);
+                break;
+            }
+            case operation::test: {
+                const Value *node = locate(op.path_ptr, op.path);
+                if (node == nullptr || !equals(*node, op.value)) {
+                    throw patch_error("Test failed at path '" + op.path + "'");
+                }
+                break;
+            }
+        }
+    }
+
+    /* reverts all the operations applied so far */
+    void rollback() {
+        while (!undo_log_.empty()) {
+            undo_entry& entry = undo_log_.back();
+            switch (entry.action) {
+                case undo_entry::erase:
+                    erase_at(entry.path);
+                    break;
+                case undo_entry::set:
+                    set_at(entry.path, entry.value);
+                    break;
+                case undo_entry::insert:
+                    insert_at(entry.path, entry.value);
+                    break;
+                case undo_entry::move_back: {
+                    Value moved = JSON_MOVE(*locate(Pointer(entry.path), entry.path));
+                    erase_at(entry.path);
+                    insert_at(entry.from, moved);
+                    break;
+                }
+                case undo_entry::root:
+                    target_ = JSON_MOVE(entry.value);
+                    break;
+            }
+            undo_log_.pop_back();
+        }
+    }
+
+private:
+    /* RFC-6902 "add", returns the concrete path of the new value */
+    std::string add(const operation& op, Value& value) {
+        if (op.path.empty()) {
+            undo_log_.push_back(undo_entry(undo_entry::root, std::string()));
+            undo_log_.back().value = JSON_MOVE(target_);
+            target_ = JSON_MOVE(value);
+            return std::string();
+        }
+
+        Value *parent = target_.find(op.parent_ptr);
+        if (parent == nullptr || !(parent->is_object() || parent->is_array())) {
+            throw patch_error("Path '" + op.parent_path + "' does not exist");
+        }
+
+        std::string prefix = concrete(op.parent_path); // before the change, <key>=<value> may not match after it
+
+        if (parent->is_array()) {
+            size_t index = parent->size();
+            if (op.last != "-" && !parse_index(op.last, index)) {
+                throw patch_error("Invalid array index at path '" + op.path + "'");
+            }
+            if (index > parent->size()) {
+                throw patch_error("Array index out of range at path '" + op.path + "'");
+            }
+            std::string token = detail::to_string(static_cast<uint64_t>(index));
+            parent->insert(Pointer("/" + token), JSON_MOVE(value));
+            undo_log_.push_back(undo_entry(undo_entry::erase, prefix + "/" + token));
+        } else if (parent->exists(op.last)) {
+            Value& member = (*parent)[op.last];
+            undo_log_.push_back(undo_entry(undo_entry::set, prefix + "/" + escape(op.last)));
+            undo_log_.back().value = JSON_MOVE(member);
+            member = JSON_MOVE(value);
+        } else {
+            (*parent)[op.last] = JSON_MOVE(value);
+            undo_log_.push_back(undo_entry(undo_entry::erase, prefix + "/" + escape(op.last)));
+        }
+
+        return undo_log_.back().path;
+    }
+
+    /* removes the value at `path` and returns it, `where` is set to where it was */
+    Value take(const Pointer& path_ptr,
+               const std::string& path,
+               const Pointer& parent_ptr,
+               const std::string& parent_path,
+               const std::string& last,
+               std::string& where) {
+        Value *node = locate(path_ptr, path);
+        if (node == nullptr || node == &target_) {
+            throw patch_error("Path to remove does not exist");
+        }
+
+        where = concrete_path(parent_ptr, parent_path, last, node);
+        Value removed = JSON_MOVE(*node);
+        erase_at(where);
+        return removed;
+    }
+
+    /*
+     * The value at `path`, compiled into `ptr`, or nullptr. As defined by RFC-6901, "/" is
+     * the member "" of the document, not the document itself as for Pointer. Only that
+     * path needs care, "" is an ordinary token anywhere else (e.g. "//a").
+     */
+    Value *locate(const Pointer& ptr, const std::string& path) {
+        if (path != "/") {
+            return target_.find(ptr);
+        }
+        if (!target_.is_object() || !target_.exists(std::string())) {
+            return nullptr;
+        }
+        return &target_[std::string()];
+    }
+
+    /* the changes made by rollback, at concrete paths read as locate() does (`value` is moved) */
+
+    void erase_at(const std::string& path) {
+        if (path == "/") {
+            target_.erase(std::string());
+        } else {
+            target_.erase(Pointer(path));
+        }
+    }
+
+    void set_at(const std::string& path, Value& value) {
+        if (path == "/") {
+            target_[std::string()] = JSON_MOVE(value);
+        } else {
+            target_.set(Pointer(path), JSON_MOVE(value));
+        }
+    }
+
+    void insert_at(const std::string& path, Value& value) {
+        if (path == "/") {
+            target_[std::string()] = JSON_MOVE(value);
+        } else {
+            target_.insert(Pointer(path), JSON_MOVE(value));
+        }
+    }
+
+    /* the path of `node`, a child of the value at `parent_ptr`, made of its actual index or key */
+    std::string concrete_path(const Pointer& parent_ptr,
+                              const std::string& parent_path,
+                              const std::string& last,
+                              const Value *node) {
+        const Value& parent = *target_.find(parent_ptr);
+        std::string prefix = concrete(parent_path);
+        if (parent.is_array()) {
+            size_t index = static_cast<size_t>(node - &*parent.abegin());
+            return prefix + "/" + detail::to_string(static_cast<uint64_t>(index));
+        }
+        Value::const_iterator member = parent.find(last);
+        if (member != parent.end() && &member->second == node) {
+            return prefix + "/" + escape(last);
+        }
+        for (Value::const_iterator it = parent.begin(), end = parent.end(); it != end; ++it) {
+            if (&it->second == node) {
+                return prefix + "/" + escape(it->first);
+            }
+        }
+        return std::string(); // not reached
+    }
+
+    /* `path`, an existing value, with its <key>=<value> tokens resolved to actual indices or keys */
+    std::string concrete(const std::string& path) {
+        if (path.find('=') == std::string::npos) {
+            return path; // nothing to resolve
+        }
+        const Value *node = target_.find(Pointer(path));
+        std::string parent = parent_of(path);
+        return node == nullptr ? path : concrete_path(Pointer(parent), parent, last_of(path), node);
+    }
+
+    /* array index as defined by RFC-6901: digits without leading zeros */
+    static bool parse_index(const std::string& token, size_t& index) {
+        if (token.empty() || (token.size() > 1 && token[0] == '0')) {
+            return false;
+        }
+        index = 0;
+        for (std::string::const_iterator it = token.begin(), end = token.end(); it != end; ++it) {
+            if (*it < '0' || *it > '9' || index > (static_cast<size_t>(-1) - 9) / 10) {
+                return false;
+            }
+            index = index * 10 + static_cast<size_t>(*it - '0');
+        }
+        return true;
+    }
+};
+
+void Patch::apply(Value& target) const {
+    context ctx(target);
+    try {
+        for (std::vector<operation>::const_iterator it = operations_.begin(), end = operations_.end(); it != end; ++it) {
+            ctx.apply(*it);
+        }
+    } catch (...) {
+        ctx.rollback();
+        throw;
+    }
+}
+
+/* computes the operations turning a JSON into another one */
+
+class differ {
+#if JSON_HAVE_CXX11
+    typedef std::unordered_map<const Value*, uint64_t> hash_cache;
+#else
+    typedef std::map<const Value*, uint64_t>           hash_cache;
+#endif
+
+    static const size_t max_lcs_cells = 1 << 22; /* larger arrays are compared by position */
+
+    hash_cache hashes_;
+    Value      patch_;
+
+public:
+    differ()
+        : patch_(Value::array_type()) {
+    }
+
+    Value& run(const Value& from, const Value& to) {
+        compare(from, to, std::string());
+        return patch_;
+    }
+
+private:
+    /* json::hash, cached by address since arrays are compared element by element */
+    uint64_t hash(const Value& obj) {
+        hash_cache::const_iterator cached = hashes_.find(&obj);
+        if (cached != hashes_.end()) {
+            return cached->second;
+        }
+        return hashes_[&obj] = json::hash(obj);
+    }
+
+    bool same(const Value& lhs, const Value& rhs) {
+        return &lhs == &rhs || (hash(lhs) == hash(rhs) && equals(lhs, rhs));
+    }
+
+    void emit(const char *op, const std::string& path, const Value *value) {
+        Value& entry = patch_.push_back(Value());
+        entry["op"] = op;
+        entry["path"] = path;
+        if (value != nullptr) {
+            entry["value"] = *value;
+        }
+    }
+
+    void compare(const Value& from, const Value& to, const std::string& path) {
+        if (same(from, to)) {
+            return;
+        }
+
+        if (from.is_object() && to.is_object() && !from.empty() && !to.empty()) {
+            compare_objects(from, to, path);
+        } else if (from.is_array() && to.is_array() && !from.empty() && !to.empty()) {
+            compare_arrays(from, to, path);
+        } else {
+            emit("replace", path, &to);
+        }
+    }
+
+    void compare_objects(const Value& from, const Value& to, const std::string& path) {
+        if (path.empty() && !same_member(from, to, std::string())) {
+            // the pointer to a top-level empty key would be "/", the whole document
+            emit("replace", path, &to);
+            return;
+        }
+
+        Value::const_iterator f = from.begin(), t = to.begin();
+        while (f != from.end() || t != to.end()) {
+            if (t == to.end() || (f != from.end() && f->first < t->first)) {
+                emit("remove", path + "/" + escape(f->first), nullptr);
+                ++f;
+            } else if (f == from.end() || t->first < f->first) {
+                emit("add", path + "/" + escape(t->first), &t->second);
+                ++t;
+            } else {
+                compare(f->second, t->second, path + "/" + escape(f->first));
+                ++f;
+                ++t;
+            }
+        }
+    }
+
+    void compare_arrays(const Value& from, const Value& to, const std::string& path) {
+        size_t n = from.size(), m = to.size();
+
+        // common prefix and suffix
+        size_t prefix = 0;
+        while (prefix < n && prefix < m && same(from[prefix], to[prefix])) {
+            ++prefix;
+        }
+        size_t suffix = 0;
+        while (suffix < n - prefix && suffix < m - prefix && same(from[n - 1 - suffix], to[m - 1 - suffix])) {
+            ++suffix;
+        }
+
+        size_t rows = n - prefix - suffix, cols = m - prefix - suffix;
+        if (rows == 0 || cols == 0 || rows * cols > max_lcs_cells) {
+            // by position: changed elements, then the extra ones
+            size_t common = rows < cols ? rows : cols;
+            for (size_t i = 0; i < common; ++i) {
+                compare(from[prefix + i], to[prefix + i], index_path(path, prefix + i));
+            }
+            for (size_t i = common; i < rows; ++i) {
+                emit("remove", index_path(path, prefix + common), nullptr);
+            }
+            for (size_t i = common; i < cols; ++i) {
+                emit("add", index_path(path, prefix + i), &to[prefix + i]);
+            }
+            return;
+        }
+
+        // longest common subsequence of the middle part, lcs[i][j] is for from[i..] and to[j..]
+        std::vector<uint32_t> lcs((rows + 1) * (cols + 1), 0);
+        for (size_t i = rows; i-- > 0; ) {
+            for (size_t j = cols; j-- > 0; ) {
+                uint32_t& cell = lcs[i * (cols + 1) + j];
+                if (hash(from[prefix + i]) == hash(to[prefix + j]) && same(from[prefix + i], to[prefix + j])) {
+                    cell = lcs[(i + 1) * (cols + 1) + j + 1] + 1;
+                } else {
+                    uint32_t down = lcs[(i + 1) * (cols + 1) + j], right = lcs[i * (cols + 1) + j + 1];
+                    cell = down > right ? down : right;
+                }
+            }
+        }
+
+        // walk the table, `position` is the index in the array being patched
+        size_t i = 0, j = 0, position = prefix;
+        while (i < rows || j < cols) {
+            bool keep = i < rows && j < cols
+                        && lcs[i * (cols + 1) + j] == lcs[(i + 1) * (cols + 1) + j + 1] + 1
+                        && same(from[prefix + i], to[prefix + j]);
+            if (keep) {
+                ++i, ++j, ++position;
+                continue;
+            }
+
+            uint32_t here = i < rows && j < cols ? lcs[i * (cols + 1) + j] : 0;
+            if (i < rows && j < cols && lcs[(i + 1) * (cols + 1) + j + 1] == here) {
+                // the element changed, pairing them loses no common element
+                compare(from[prefix + i], to[prefix + j], index_path(path, position));
+                ++i, ++j, ++position;
+            } else if (j == cols || (i < rows && lcs[(i + 1) * (cols + 1) + j] >= lcs[i * (cols + 1) + j + 1])) {
+                emit("remove", index_path(path, position), nullptr);
+                ++i;
+            } else {
+                emit("add", index_path(path, position), &to[prefix + j]);
+                ++j, ++position;
+            }
+        }
+    }
+
+    /* checks if both objects lack the member `key` or have the same value for it */
+    bool same_member(const Value& from, const Value& to, const std::string& key) {
+        Value::const_iterator f = from.find(key), t = to.find(key);
+        if (f == from.end() || t == to.end()) {
+            return f == from.end() && t == to.end();
+        }
+        return same(f->second, t->second);
+    }
+
+    static std::string index_path(const std::string& path, size_t index) {
+        return path + "/" + detail::to_string(static_cast<uint64_t>(index));
+    }
+};
+
+Value diff(const Value& from, const Value& to) {
+    differ engine;
+    return engine.run(from, to);
+}
+
+} // namespace json
@@ -10,57 +10,232 @@
 #include "json/value.hpp"
 #include "json/errors.hpp"
 
+#include <cstddef>
+#include <cstdlib>
+#include <stdexcept>
+
 namespace json {
 
+const json_spec_index option_index = {};
+
 Pointer::Pointer(const std::string& spec)
-    : tokens_(make_tokens(spec)) {
+    : tokens_(make_tokens(spec, false)) {
+}
+
+Pointer::Pointer(const std::string& spec, const json_spec_index&)
+    : tokens_(make_tokens(spec, true)) {
 }
 
 const Value& Pointer::get_reference(const Value& tgt) const {
+    const Value *parent;
+    std::vector<token>::const_iterator missing;
+
+    const Value *obj = resolve(tgt, parent, missing);
+    if (obj == nullptr) {
+        switch (parent->type_) {
+            case Type::Object:
+                throw key_not_found(missing->key);
+            case Type::Array:
+                throw std::out_of_range("Reference token '" + missing->key + "' is out of range");
+            default:
+                throw std::out_of_range("Unresolved reference token " + missing->key);
+        }
+    }
+
+    return *obj;
+}
+
+const Value *Pointer::find(const Value& tgt) const {
+    const Value *parent;
+    std::vector<token>::const_iterator missing;
+    return resolve(tgt, parent, missing);
+}
+
+bool Pointer::is_valid_for(const Value &tgt) const {
+    return find(tgt) != nullptr;
+}
+
+Value& Pointer::get_or_create(Value& tgt) const {
+    if (tokens_.empty()) {
+        return tgt;
+    }
+    return step_or_create(create_parent(tgt), tokens_.back(), false);
+}
+
+Value& Pointer::insert_into(Value& tgt) const {
+    if (tokens_.empty()) {
+        return tgt;
+    }
+    return step_or_create(create_parent(tgt), tokens_.back(), true);
+}
+
+bool Pointer::erase_from(Value& tgt) const {
+    if (tokens_.empty()) {
+        return false;
+    }
+
     const Value *obj = &tgt;
+    for (std::vector<token>::const_iterator it = tokens_.begin(), end = tokens_.end() - 1; it != end; ++it) {
+        if ((obj = step(obj, *it)) == nullptr) {
+            return false;
+        }
+    }
 
-    std::vector<std::string>::const_iterator it, end;
-    for (it = tokens_.begin(), end = tokens_.end(); it != end; ++it) {
-        const std::string& token = *it;
-        switch (obj->type_) {
-            case Type::Object: {
-                Value::const_iterator it = obj->value_.map_val.find(token);
-                if (it != obj->value_.map_val.end()) {
-                    obj = &it->second;
-                } else if (!get_by_property_value(obj, token)) { // try <key>=<value> scheme
-                    throw key_not_found(token);
+    Value& parent = create_parent(tgt); // the path exists, but shared containers must be copied
+    const token& tok = tokens_.back();
+    parent.expand();
+    parent.lookups_.clear();
+    switch (parent.type_) {
+        case Type::Object: {
+            Value::map_type& map = parent.value_.map_val.write();
+            Value::iterator it = map.find(tok.key);
+            if (it == map.end() && tok.has_filter) {
+                for (it = map.begin(); it != map.end() && !is_a_match(it->second, tok); ++it) {
                 }
-                break;
             }
-            case Type::Array: {
-                if (token == "-" || (token.size() > 1 && (token[0] == '0' || token[0] == '-'))) {
-                    throw parse_error(std::string("Reference token '") + token  + "' is invalid in this context");
-                }
-                if (!get_by_property_value(obj, token)) {
-                    try {
-                        obj = &obj->value_.arr_val.at(static_cast<size_t>(detail::stoi64(token)));
-                    } catch (const std::invalid_argument&) {
-                        throw parse_error(std::string("Reference token '") + token  + "' is not a number");
+            if (it == map.end()) {
+                return false;
+            }
+            map.erase(it);
+            return true;
+        }
+        case Type::Array: {
+            if (tok.bad_index) {
+                throw parse_error(std::string("Reference token '") + tok.key  + "' is invalid in this context");
+            }
+            Value::array_type& array = parent.value_.arr_val.write();
+            if (tok.has_filter) {
+                for (Value::array_iterator it = array.begin(); it != array.end(); ++it) {
+                    if (is_a_match(*it, tok)) {
+                        array.erase(it);
+                        return true;
                     }
                 }
-                break;
             }
-            default:
-                throw std::out_of_range("Unresolved reference token " + token);
+            if (!tok.has_index) {
+                throw parse_error(std::string("Reference token '") + tok.key  + "' is not a number");
+            }
+            if (tok.index >= array.size()) {
+                return false;
+            }
+            array.erase(array.begin() + static_cast<std::ptrdiff_t>(tok.index));
+            return true;
         }
+        default:
+            return false;
     }
+}
 
+Value& Pointer::create_parent(Value& tgt) const {
+    Value *obj = &tgt;
+    for (std::vector<token>::const_iterator it = tokens_.begin(), end = tokens_.end() - 1; it != end; ++it) {
+        obj = &step_or_create(*obj, *it, false);
+    }
     return *obj;
 }
 
-bool Pointer::is_valid_for(const Value &tgt) const {
-    try {
-        get_reference(tgt);
-        return true;
-    } catch (const key_not_found&) {
-        return false;
-    } catch (const std::out_of_range&) {
-        return false;
+Value& Pointer::step_or_create(Value& obj, const token& tok, bool insert) {
+    obj.expand();
+    obj.lookups_.clear();
+    obj.fill_placeholder();
+
+    if (obj.type_ == Type::Object) {
+        if (tok.key != "-" || !obj.value_.map_val->empty()) {
+            Value::map_type& map = obj.value_.map_val.leak();
+            Value::iterator it = map.find(tok.key);
+            if (it != map.end()) {
+                return it->second;
+            }
+            const Value *match = &obj;
+            if (get_by_property_value(match, tok)) {
+                return const_cast<Value&>(*match);
+            }
+            return map[tok.key];
+        }
+        obj.type_ = Type::Array; // appending to an empty object, change type to array
+    }
+
+    if (obj.type_ != Type::Array) {
+        throw bad_json_type(Type::Object, obj.type_);
+    }
+
+    Value::array_type& array = obj.value_.arr_val.leak();
+    if (tok.key == "-") {
+        array.push_back(Value());
+        return array.back();
+    }
+    if (tok.bad_index) {
+        throw parse_error(std::string("Reference token '") + tok.key  + "' is invalid in this context");
+    }
+    if (!insert) {
+        const Value *match = &obj;
+        if (get_by_property_value(match, tok)) {
+            return const_cast<Value&>(*match);
+        }
+    }
+    if (!tok.has_index) {
+        throw parse_error(std::string("Reference token '") + tok.key  + "' is not a number");
+    }
+    if (tok.index > array.size()) {
+        throw std::out_of_range("Reference token '" + tok.key + "' is out of range");
+    }
+    if (tok.index == array.size()) {
+        array.push_back(Value());
+        return array.back();
+    }
+    if (insert) {
+        return *array.insert(array.begin() + static_cast<std::ptrdiff_t>(tok.index), Value());
+    }
+    return array[tok.index];
+}
+
+const Value *Pointer::resolve(const Value& tgt,
+                              const Value * & parent,
+                              std::vector<token>::const_iterator& missing) const {
+    const Value *obj = &tgt;
+
+    std::vector<token>::const_iterator it, end;
+    for (it = tokens_.begin(), end = tokens_.end(); it != end; ++it) {
+        parent = obj;
+        missing = it;
+        if ((obj = step(obj, *it)) == nullptr) {
+            break;
+        }
+    }
+
+    return obj;
+}
+
+const Value *Pointer::step(const Value *obj, const token& tok) {
+    obj->expand();
+    switch (obj->type_) {
+        case Type::Object: {
+            Value::const_iterator it = obj->value_.map_val->find(tok.key);
+            if (it != obj->value_.map_val->end()) {
+                return &it->second;
+            }
+            if (get_by_property_value(obj, tok)) { // try <key>=<value> scheme
+                return obj;
+            }
+            return nullptr;
+        }
+        case Type::Array: {
+            if (tok.bad_index) {
+                throw parse_error(std::string("Reference token '") + tok.key  + "' is invalid in this context");
+            }
+            if (get_by_property_value(obj, tok)) {
+                return obj;
+            }
+            if (!tok.has_index) {
+                throw parse_error(std::string("Reference token '") + tok.key  + "' is not a number");
+            }
+            if (tok.index >= obj->value_.arr_val->size()) {
+                return nullptr;
+            }
+            return &(*obj->value_.arr_val)[tok.index];
+        }
+        default:
+            return nullptr;
     }
 }
 
@@ -85,8 +260,8 @@ void Pointer::unescape(std::string& token) {
     }
 }
 
-std::vector<std::string> Pointer::make_tokens(const std::string& spec) {
-    std::vector<std::string> tokens;
+std::vector<Pointer::token> Pointer::make_tokens(const std::string& spec, bool use_index) {
+    std::vector<token> tokens;
 
     if (spec.empty() || (spec.size() == 1 && spec[0] == '/')) {
         return tokens; // whole JSON
@@ -99,26 +274,155 @@ std::vector<std::string> Pointer::make_tokens(const std::string& spec) {
     for (size_t slash = spec.find_first_of('/', 1), start = 1;
             start != 0;
             start = slash + 1, slash = spec.find_first_of('/', start)) {
-        tokens.push_back(spec.substr(start, slash-start));
-        unescape(tokens.back());
+        std::string reference = spec.substr(start, slash-start);
+        unescape(reference);
+        tokens.push_back(token(reference, use_index));
     }
 
     return tokens;
 }
 
-bool Pointer::is_a_match(const Value& obj, const std::string key, const std::string value) {
+/* a key of the lookup indexes: a type tag followed by the bytes of the value */
+static std::string tagged(char tag, const void *data, size_t size) {
+    std::string key(1, tag);
+    key.append(static_cast<const char*>(data), size);
+    return key;
+}
+
+Pointer::token::token(const std::string& spec, bool use_index)
+    : key(spec),
+      filter_int(0),
+      filter_dbl(0),
+      index(0),
+      has_filter(false),
+      has_filter_int(false),
+      has_filter_dbl(false),
+      has_index(!spec.empty()),
+      bad_index(spec == "-" || (spec.size() > 1 && (spec[0] == '0' || spec[0] == '-'))),
+      use_index(use_index) {
+    for (std::string::const_iterator it = spec.begin(), end = spec.end(); it != end && has_index; ++it) {
+        if (*it < '0' || *it > '9') {
+            has_index = false;
+        } else if (index > (static_cast<size_t>(-1) - 9) / 10) {
+            index = static_cast<size_t>(-1); // out of range anyway
+        } else {
+            index = index * 10 + static_cast<size_t>(*it - '0');
+        }
+    }
+
+    size_t pos = spec.find_first_of('=');
+    if (pos == std::string::npos) {
+        return;
+    }
+
+    has_filter = true;
+    filter_key = spec.substr(0, pos);
+    filter_value = spec.substr(pos + 1);
+
+    const char *value = filter_value.c_str();
+    if (*value == '-' || (*value >= '0' && *value <= '9')) {
+        try {
+            filter_int = detail::stoi64(filter_value);
+            // integers match their canonical representation only
+            has_filter_int = (detail::to_string(filter_int) == filter_value);
+        } catch (const std::invalid_argument&) {
+        } catch (const std::out_of_range&) {
+        }
+
+        char *end;
+        filter_dbl = strtod(value, &end);
+        has_filter_dbl = (end == value + filter_value.size());
+    }
+
+    index_keys.push_back(tagged('s', filter_value.data(), filter_value.size()));
+    if (filter_value == "null") {
+        index_keys.push_back(tagged('n', nullptr, 0));
+    } else if (filter_value == "true" || filter_value == "false") {
+        index_keys.push_back(tagged('b', filter_value == "true" ? "1" : "0", 1));
+    }
+    if (has_filter_int) {
+        index_keys.push_back(tagged('i', &filter_int, sizeof(filter_int)));
+    }
+    if (has_filter_dbl) {
+        double number = filter_dbl == 0 ? 0.0 : filter_dbl; // -0.0 == 0.0
+        index_keys.push_back(tagged('d', &number, sizeof(number)));
+    }
+}
+
+bool Pointer::index_key(const Value& obj, std::string& key) {
+    switch (obj.type_) {
+        case Type::Null:
+            key = tagged('n', nullptr, 0);
+            return true;
+        case Type::Boolean:
+            key = tagged('b', obj.value_.bool_val ? "1" : "0", 1);
+            return true;
+        case Type::Integer:
+            key = tagged('i', &obj.value_.int_val, sizeof(obj.value_.int_val));
+            return true;
+        case Type::Double: {
+            double number = obj.value_.dbl_val == 0 ? 0.0 : obj.value_.dbl_val; // -0.0 == 0.0
+            key = tagged('d', &number, sizeof(number));
+            return true;
+        }
+        case Type::String:
+            key = tagged('s', obj.value_.str_val.data(), obj.value_.str_val.size());
+            return true;
+        default:
+            return false;
+    }
+}
+
+const detail::lookup_cache::index_type& Pointer::build_index(const Value& obj, const std::string& key) {
+    detail::lookup_cache::index_type& index = obj.lookups_.create(key);
+
+    std::string value_key;
+    size_t position = 0;
+    const Value *child = nullptr;
+    Value::const_iterator mit = obj.value_.map_val->begin();
+    Value::const_array_iterator ait = obj.value_.arr_val->begin();
+    for (;; ++position) {
+        if (obj.type_ == Type::Object) {
+            if (mit == obj.value_.map_val->end()) {
+                break;
+            }
+            child = &(mit++)->second;
+        } else {
+            if (ait == obj.value_.arr_val->end()) {
+                break;
+            }
+            child = &*(ait++);
+        }
+
+        child->expand();
+        if (child->type_ != Type::Object) {
+            continue;
+        }
+        Value::const_iterator member = child->value_.map_val->find(key);
+        if (member != child->value_.map_val->end() && index_key(member->second, value_key)) {
+            detail::lookup_cache::entry entry = { position, child };
+            index.insert(std::make_pair(value_key, entry)); // keeps the first one
+        }
+    }
+
+    return index;
+}
+
+bool Pointer::is_a_match(const Value& obj, const token& tok) {
+    obj.expand();
     if (obj.type_ == Type::Object) {
-        Value::const_iterator kit = obj.value_.map_val.find(key);
-        if (kit != obj.end()) {
+        Value::const_iterator kit = obj.value_.map_val->find(tok.filter_key);
+        if (kit != obj.value_.map_val->end()) {
+            const std::string& value = tok.filter_value;
             switch (kit->second.type_) {
                 case Type::Null:
                     return (value == "null");
                 case Type::Boolean:
                     return kit->second.value_.bool_val ? (value == "true") : (value == "false");
                 case Type::Integer:
-                    return value == detail::to_string(kit->second.value_.int_val);
+                    return tok.has_filter_int && kit->second.value_.int_val == tok.filter_int;
                 case Type::Double:
-                    return value == detail::to_string(kit->second.value_.dbl_val);
+                    return tok.has_filter_dbl && kit->second.value_.dbl_val == tok.filter_dbl;
                 case Type::String:
                     return value == kit->second.value_.str_val;
                 default:
@@ -129,25 +433,48 @@ bool Pointer::is_a_match(const Value& obj, const std::string key, const std::str
     return false;
 }
 
-bool Pointer::get_by_property_value(const Value * & obj, const std::string& token) {
-    size_t pos = token.find_first_of("=");
-    if (pos != std::string::npos) {
-        std::string key = token.substr(0, pos);
-        std::string value = token.substr(pos+1);
+bool Pointer::get_by_property_value(const Value * & obj, const token& tok) {
+    if (tok.has_filter && tok.use_index) {
+        const detail::lookup_cache::index_type *index = obj->lookups_.find(tok.filter_key);
+        if (index == nullptr) {
+            index = &build_index(*obj, tok.filter_key);
+        }
+
+        const detail::lookup_cache::entry *first = nullptr;
+        for (std::vector<std::string>::const_iterator it = tok.index_keys.begin(), end = tok.index_keys.end();
+                it != end;
+                ++it) {
+            detail::lookup_cache::index_type::const_iterator found = index->find(*it);
+            if (found != index->end() && (first == nullptr || found->second.position < first->position)) {
+                first = &found->second;
+            }
+        }
+
+        if (first == nullptr) {
+            return false;
+        }
+        if (is_a_match(*first->value, tok)) {
+            obj = first->value;
+            return true;
+        }
+        obj->lookups_.clear(); // the child changed after the index was built, fall back to a scan
+    }
+
+    if (tok.has_filter) {
         if (obj->type_ == Type::Object) {
-            for (Value::const_iterator it = obj->value_.map_val.begin(), end = obj->value_.map_val.end();
+            for (Value::const_iterator it = obj->value_.map_val->begin(), end = obj->value_.map_val->end();
                     it != end;
                     ++it) {
-                if (is_a_match(it->second, key, value)) {
+                if (is_a_match(it->second, tok)) {
                     obj = &it->second;
                     return true;
                 }
             }
         } else {
-            for (Value::const_array_iterator it = obj->value_.arr_val.begin(), end = obj->value_.arr_val.end();
+            for (Value::const_array_iterator it = obj->value_.arr_val->begin(), end = obj->value_.arr_val->end();
                     it != end;
                     ++it) {
-                if (is_a_match(*it, key, value)) {
+                if (is_a_match(*it, tok)) {
                     obj = &(*it);
                     return true;
                 }
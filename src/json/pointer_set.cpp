@@ -0,0 +1,82 @@
+/*!
+ * \file pointer_set.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include "json/pointer_set.hpp"
+
+#include "json/value.hpp"
+
+namespace json {
+
+PointerSet::PointerSet()
+    : nodes_(1, node(Pointer::token(std::string()))),
+      count_(0) {
+}
+
+PointerSet::PointerSet(const std::vector<Pointer>& pointers)
+    : nodes_(1, node(Pointer::token(std::string()))),
+      count_(0) {
+    for (std::vector<Pointer>::const_iterator it = pointers.begin(), end = pointers.end(); it != end; ++it) {
+        add(*it);
+    }
+}
+
+size_t PointerSet::add(const Pointer& pointer) {
+    size_t current = 0;
+
+    std::vector<Pointer::token>::const_iterator it, end;
+    for (it = pointer.tokens_.begin(), end = pointer.tokens_.end(); it != end; ++it) {
+        size_t next = 0;
+        const std::vector<size_t>& children = nodes_[current].children;
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (nodes_[children[i]].tok.key == it->key) {
+                next = children[i];
+                nodes_[next].tok.use_index |= it->use_index;
+                break;
+            }
+        }
+        if (next == 0) {
+            next = nodes_.size();
+            nodes_.push_back(node(*it));
+            nodes_[current].children.push_back(next);
+        }
+        current = next;
+    }
+
+    nodes_[current].targets.push_back(count_);
+    return count_++;
+}
+
+size_t PointerSet::size() const {
+    return count_;
+}
+
+std::vector<const Value*> PointerSet::resolve(const Value& tgt) const {
+    std::vector<const Value*> result;
+    resolve(tgt, result);
+    return result;
+}
+
+void PointerSet::resolve(const Value& tgt, std::vector<const Value*>& result) const {
+    result.assign(count_, static_cast<const Value*>(nullptr));
+    resolve(nodes_[0], &tgt, result);
+}
+
+void PointerSet::resolve(const node& current, const Value *obj, std::vector<const Value*>& result) const {
+    for (size_t i = 0; i < current.targets.size(); ++i) {
+        result[current.targets[i]] = obj;
+    }
+
+    for (size_t i = 0; i < current.children.size(); ++i) {
+        const node& child = nodes_[current.children[i]];
+        const Value *found = Pointer::step(obj, child.tok);
+        if (found != nullptr) {
+            resolve(child, found, result);
+        }
+    }
+}
+
+} // namespace json
@@ -0,0 +1,167 @@
+/*!
+ * \file shared_document.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include "json/shared_document.hpp"
+
+#include "json/value.hpp"
+
+#if JSON_HAVE_CXX11
+#include <atomic>
+#include <mutex>
+#include <thread>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace json {
+
+/*
+ * The current tree is swapped with a single atomic exchange. Readers do not lock, but
+ * announce themselves in the counter of the current epoch while they load the tree and
+ * take their reference to it. Writers flip the epoch after the exchange and wait for the
+ * counter of the previous one to drain before dropping their reference to the old tree,
+ * so no reader can be in the middle of taking a reference to a tree being released.
+ * Readers arriving meanwhile use the other counter, so writers cannot starve.
+ *
+ * A reader checks the epoch again once counted and retries if it has moved: it may have
+ * been counted in the old epoch after the writer that flipped it stopped waiting, in
+ * which case no writer would wait for it to leave before releasing the tree it loads.
+ */
+struct SharedDocument::state {
+#if JSON_HAVE_CXX11
+    std::atomic<FrozenDocument::tree*> current;
+    std::atomic<unsigned int>          epoch;
+    std::atomic<size_t>                readers[2];
+    std::mutex                         writers;
+
+    state(FrozenDocument::tree *t)
+        : current(t),
+          epoch(0) {
+        readers[0] = 0;
+        readers[1] = 0;
+    }
+
+    unsigned int enter() {
+        for (;;) {
+            unsigned int e = epoch.load();
+            readers[e].fetch_add(1);
+            if (epoch.load() == e) {
+                return e;
+            }
+            readers[e].fetch_sub(1);
+        }
+    }
+
+    void leave(unsigned int e) {
+        readers[e].fetch_sub(1);
+    }
+
+    FrozenDocument::tree *swap(FrozenDocument::tree *t) {
+        std::lock_guard<std::mutex> lock(writers);
+        FrozenDocument::tree *old = current.exchange(t);
+        unsigned int e = epoch.load();
+        epoch.store(e ^ 1);
+        while (readers[e].load() != 0) {
+            std::this_thread::yield();
+        }
+        return old;
+    }
+#else
+    FrozenDocument::tree * volatile current;
+    volatile unsigned int           epoch;
+    volatile size_t                 readers[2];
+    pthread_mutex_t                 writers;
+
+    state(FrozenDocument::tree *t)
+        : current(t),
+          epoch(0) {
+        readers[0] = 0;
+        readers[1] = 0;
+        pthread_mutex_init(&writers, NULL);
+    }
+
+    ~state() {
+        pthread_mutex_destroy(&writers);
+    }
+
+    unsigned int enter() {
+        for (;;) {
+            __sync_synchronize();
+            unsigned int e = epoch;
+            __sync_fetch_and_add(&readers[e], 1); // a full barrier
+            if (epoch == e) {
+                return e;
+            }
+            __sync_fetch_and_sub(&readers[e], 1);
+        }
+    }
+
+    void leave(unsigned int e) {
+        __sync_fetch_and_sub(&readers[e], 1);
+    }
+
+    FrozenDocument::tree *swap(FrozenDocument::tree *t) {
+        pthread_mutex_lock(&writers);
+        FrozenDocument::tree *old = current;
+        while (!__sync_bool_compare_and_swap(&current, old, t)) {
+            old = current;
+        }
+        unsigned int e = epoch;
+        epoch = e ^ 1;
+        __sync_synchronize();
+        while (__sync_add_and_fetch(&readers[e], 0) != 0) {
+            sched_yield();
+        }
+        pthread_mutex_unlock(&writers);
+        return old;
+    }
+#endif
+
+    FrozenDocument::tree *load() {
+#if JSON_HAVE_CXX11
+        return current.load();
+#else
+        __sync_synchronize();
+        return current;
+#endif
+    }
+};
+
+SharedDocument::SharedDocument()
+    : state_(new state(nullptr)) {
+}
+
+SharedDocument::SharedDocument(const FrozenDocument& doc)
+    : state_(new state(doc.share())) {
+}
+
+SharedDocument::SharedDocument(const Value& value)
+    : state_(new state(FrozenDocument::build(value))) {
+}
+
+SharedDocument::~SharedDocument() {
+    FrozenDocument::release(state_->load());
+    delete state_;
+}
+
+FrozenDocument SharedDocument::snapshot() const {
+    unsigned int e = state_->enter();
+    FrozenDocument::tree *t = FrozenDocument::acquire(state_->load());
+    state_->leave(e);
+    return FrozenDocument(t);
+}
+
+void SharedDocument::publish(const FrozenDocument& doc) {
+    FrozenDocument::release(state_->swap(doc.share()));
+}
+
+void SharedDocument::publish(const Value& value) {
+    FrozenDocument::release(state_->swap(FrozenDocument::build(value)));
+}
+
+} // namespace json
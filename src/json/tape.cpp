@@ -0,0 +1,603 @@
+/*!
+ * \file tape.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include "json/tape.hpp"
+
+#include "json/detail/ref_count.hpp"
+#include "json/errors.hpp"
+#include "json/value.hpp"
+
+#include "detail/json_io.hpp"
+#include "detail/mapped_file.hpp"
+#include "detail/tape_format.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#define TYPE_VALID_OR_THROW(expected) do { \
+    Type::Value actual = this->type(); \
+    if (!((expected) & actual)) { \
+        throw bad_json_type(static_cast<Type::Value>(expected), actual); \
+    } \
+} while (false)
+
+namespace json {
+
+namespace format = detail::tape;
+
+/* the string of the key or string word `word` is `str` */
+static bool string_equals(const char *strings, uint64_t word, const char *str, size_t size) {
+    return format::string_size(strings, word) == size && memcmp(format::string_data(strings, word), str, size) == 0;
+}
+
+/**************/
+/* tape value */
+/**************/
+
+TapeValue::TapeValue()
+    : word_(nullptr),
+      key_(nullptr),
+      strings_(nullptr) {
+}
+
+TapeValue::TapeValue(const uint64_t *word, const uint64_t *key, const char *strings)
+    : word_(word),
+      key_(key),
+      strings_(strings) {
+}
+
+Type::Value TapeValue::type() const {
+    if (word_ == nullptr) {
+        return Type::Null;
+    }
+    switch (format::tag_of(*word_)) {
+        case format::true_tag:
+        case format::false_tag:
+            return Type::Boolean;
+        case format::small_tag:
+        case format::int_tag:
+            return Type::Integer;
+        case format::double_tag:
+            return Type::Double;
+        case format::string_tag:
+            return Type::String;
+        case format::object_tag:
+            return Type::Object;
+        case format::array_tag:
+            return Type::Array;
+        default:
+            return Type::Null;
+    }
+}
+
+bool TapeValue::empty() const {
+    return (type() & (Type::Object|Type::Array)) && format::width_of(*word_) == 2;
+}
+
+size_t TapeValue::size() const {
+    TYPE_VALID_OR_THROW(Type::Object|Type::Array);
+    uint64_t count = format::count_of(*word_);
+    if (count < format::max_count) {
+        return static_cast<size_t>(count);
+    }
+    return static_cast<size_t>(std::distance(begin(), end())); // saturated
+}
+
+std::string TapeValue::key() const {
+    if (key_ == nullptr) {
+        return std::string();
+    }
+    return std::string(format::string_data(strings_, *key_), format::string_size(strings_, *key_));
+}
+
+bool TapeValue::exists(const std::string& key) const {
+    return find(key).valid();
+}
+
+bool TapeValue::to_bool() const {
+    TYPE_VALID_OR_THROW(Type::Boolean);
+    return format::tag_of(*word_) == format::true_tag;
+}
+
+int64_t TapeValue::to_int() const {
+    TYPE_VALID_OR_THROW(Type::Integer);
+    if (format::tag_of(*word_) == format::small_tag) {
+        return format::small_of(*word_);
+    }
+    int64_t value;
+    memcpy(&value, word_ + 1, sizeof(value));
+    return value;
+}
+
+double TapeValue::to_double() const {
+    TYPE_VALID_OR_THROW(Type::Double|Type::Integer);
+    if (format::tag_of(*word_) != format::double_tag) {
+        return static_cast<double>(to_int());
+    }
+    double value;
+    memcpy(&value, word_ + 1, sizeof(value));
+    return value;
+}
+
+std::string TapeValue::to_string() const {
+    TYPE_VALID_OR_THROW(Type::String);
+    return std::string(format::string_data(strings_, *word_), format::string_size(strings_, *word_));
+}
+
+const char *TapeValue::c_str() const {
+    TYPE_VALID_OR_THROW(Type::String);
+    return format::string_data(strings_, *word_);
+}
+
+TapeValue TapeValue::operator[](const std::string& key) const {
+    Type::Value type = this->type();
+    if (type != Type::Object && !(type == Type::Array && empty())) { // like Value, accept empty arrays
+        throw bad_json_type(Type::Object, type);
+    }
+    TapeValue member = find(key);
+    if (!member.valid()) {
+        throw key_not_found(key);
+    }
+    return member;
+}
+
+TapeValue TapeValue::operator[](size_t idx) const {
+    TYPE_VALID_OR_THROW(Type::Array);
+    const_iterator it = begin(), end = this->end();
+    for (size_t i = 0; i < idx && it != end; ++i) {
+        ++it;
+    }
+    if (it == end) {
+        throw std::out_of_range("Index " + detail::to_string(static_cast<uint64_t>(idx)) + " is out of range");
+    }
+    return *it;
+}
+
+TapeValue TapeValue::operator[](const Pointer& pointer) const {
+    TapeValue obj = *this;
+    for (std::vector<Pointer::token>::const_iterator it = pointer.tokens_.begin(), end = pointer.tokens_.end();
+            it != end;
+            ++it) {
+        if (!(obj = step(obj, *it)).valid()) {
+            throw key_not_found(it->key);
+        }
+    }
+    return obj;
+}
+
+TapeValue TapeValue::find(const std::string& key) const {
+    if (type() != Type::Object) {
+        return TapeValue();
+    }
+
+    // members are not sorted, but skipping each value takes constant time; all of them are
+    // looked at since the last one having the key wins, as when parsed into a Value
+    TapeValue found;
+    for (const_iterator it = begin(), end = this->end(); it != end; ++it) {
+        if (string_equals(strings_, *it->key_, key.data(), key.size())) {
+            found = *it;
+        }
+    }
+    return found;
+}
+
+TapeValue TapeValue::find(const Pointer& pointer) const {
+    TapeValue obj = *this;
+    for (std::vector<Pointer::token>::const_iterator it = pointer.tokens_.begin(), end = pointer.tokens_.end();
+            it != end && obj.valid();
+            ++it) {
+        obj = step(obj, *it);
+    }
+    return obj;
+}
+
+TapeValue::const_iterator TapeValue::begin() const {
+    TYPE_VALID_OR_THROW(Type::Object|Type::Array);
+    return const_iterator(word_ + 1, format::tag_of(*word_) == format::object_tag, strings_);
+}
+
+TapeValue::const_iterator TapeValue::end() const {
+    TYPE_VALID_OR_THROW(Type::Object|Type::Array);
+    return const_iterator(next() - 1, format::tag_of(*word_) == format::object_tag, strings_);
+}
+
+Value TapeValue::thaw() const {
+    switch (type()) {
+        case Type::Null:
+            return Value::Null;
+        case Type::Boolean:
+            return Value(to_bool());
+        case Type::Integer:
+            return Value(to_int());
+        case Type::Double:
+            return Value(to_double());
+        case Type::String:
+            return Value(to_string());
+        case Type::Array: {
+            Value::array_type array;
+            array.reserve(size());
+            for (const_iterator it = begin(), end = this->end(); it != end; ++it) {
+                array.push_back(it->thaw());
+            }
+            return Value(array);
+        }
+        default: {
+            Value::map_type map;
+            for (const_iterator it = begin(), end = this->end(); it != end; ++it) {
+                map[it->key()] = it->thaw(); // the last one wins, as in find()
+            }
+            return Value(map);
+        }
+    }
+}
+
+std::string TapeValue::stringify(bool pretty) const {
+    return thaw().stringify(pretty);
+}
+
+const uint64_t *TapeValue::next() const {
+    return word_ + format::width_of(*word_);
+}
+
+TapeValue TapeValue::step(const TapeValue& obj, const Pointer::token& tok) {
+    switch (obj.type()) {
+        case Type::Object: {
+            TapeValue member = obj.find(tok.key);
+            if (!member.valid() && tok.has_filter) { // try <key>=<value> scheme
+                for (const_iterator it = obj.begin(), end = obj.end(); it != end; ++it) {
+                    if (is_a_match(*it, tok)) {
+                        return *it;
+                    }
+                }
+            }
+            return member;
+        }
+        case Type::Array: {
+            if (tok.bad_index) {
+                throw parse_error(std::string("Reference token '") + tok.key  + "' is invalid in this context");
+            }
+            if (tok.has_filter) {
+                for (const_iterator it = obj.begin(), end = obj.end(); it != end; ++it) {
+                    if (is_a_match(*it, tok)) {
+                        return *it;
+                    }
+                }
+            }
+            if (!tok.has_index) {
+                throw parse_error(std::string("Reference token '") + tok.key  + "' is not a number");
+            }
+            const_iterator it = obj.begin(), end = obj.end();
+            for (size_t i = 0; i < tok.index && it != end; ++i) {
+                ++it;
+            }
+            return it != end ? *it : TapeValue();
+        }
+        default:
+            return TapeValue();
+    }
+}
+
+bool TapeValue::is_a_match(const TapeValue& obj, const Pointer::token& tok) {
+    TapeValue member = obj.find(tok.filter_key);
+    if (!member.valid()) {
+        return false;
+    }
+
+    const std::string& value = tok.filter_value;
+    switch (member.type()) {
+        case Type::Null:
+            return (value == "null");
+        case Type::Boolean:
+            return member.to_bool() ? (value == "true") : (value == "false");
+        case Type::Integer:
+            return tok.has_filter_int && member.to_int() == tok.filter_int;
+        case Type::Double:
+            return tok.has_filter_dbl && member.to_double() == tok.filter_dbl;
+        case Type::String:
+            return string_equals(member.strings_, *member.word_, value.data(), value.size());
+        default:
+            return false;
+    }
+}
+
+/*****************/
+/* tape iterator */
+/*****************/
+
+TapeValue::const_iterator::const_iterator()
+    : pos_(nullptr),
+      object_(false) {
+}
+
+TapeValue::const_iterator::const_iterator(const uint64_t *pos, bool object, const char *strings)
+    : pos_(pos),
+      object_(object),
+      current_(nullptr, nullptr, strings) {
+    load();
+}
+
+TapeValue::const_iterator& TapeValue::const_iterator::operator++() {
+    pos_ = current_.next();
+    load();
+    return *this;
+}
+
+void TapeValue::const_iterator::load() {
+    switch (format::tag_of(*pos_)) {
+        case format::object_end:
+        case format::array_end:
+            current_.word_ = nullptr; // past the end
+            current_.key_ = nullptr;
+            break;
+        default:
+            current_.word_ = object_ ? pos_ + 1 : pos_;
+            current_.key_ = object_ ? pos_ : nullptr;
+            break;
+    }
+}
+
+/*****************/
+/* tape document */
+/*****************/
+
+struct TapeDocument::tape {
+    detail::ref_count     refs;
+    std::vector<uint64_t> words;    /* see tape_format.hpp */
+    std::vector<char>     strings;  /* strings and keys, prefixed by their length */
+    detail::mapped_file   snapshot; /* holds the words and strings instead, if opened from a file */
+    const uint64_t       *first;    /* the words, wherever they are */
+    const char           *pool;     /* the strings, wherever they are */
+    size_t                count;
+    size_t                pool_size;
+
+    tape()
+        : first(nullptr),
+          pool(nullptr),
+          count(0),
+          pool_size(0) {
+    }
+
+    /* points at the (filled) vectors */
+    void own() {
+        first = &words[0];
+        pool = strings.empty() ? nullptr : &strings[0];
+        count = words.size();
+        pool_size = strings.size();
+    }
+};
+
+/* the root of documents holding null */
+static const uint64_t null_word = format::make_word(format::null_tag, 0);
+
+/* appends the words of `value` */
+static void write(const Value& value, format::writer& out) {
+    switch (value.type()) {
+        case Type::Null:
+            out.literal(format::null_tag);
+            break;
+        case Type::Boolean:
+            out.literal(value.to_bool() ? format::true_tag : format::false_tag);
+            break;
+        case Type::Integer:
+            out.integer(value.to_int());
+            break;
+        case Type::Double:
+            out.real(value.to_double());
+            break;
+        case Type::String:
+            out.string(value.to_string().data(), value.to_string().size());
+            break;
+        case Type::Array:
+            out.open(format::array_tag);
+            for (Value::const_array_iterator it = value.abegin(), end = value.aend(); it != end; ++it) {
+                write(*it, out);
+            }
+            if (!out.close(format::array_end)) {
+                throw std::length_error("Container too large for a tape");
+            }
+            break;
+        default:
+            out.open(format::object_tag);
+            for (Value::const_iterator it = value.begin(), end = value.end(); it != end; ++it) {
+                out.key(it->first.data(), it->first.size());
+                write(it->second, out);
+            }
+            if (!out.close(format::object_end)) {
+                throw std::length_error("Container too large for a tape");
+            }
+            break;
+    }
+}
+
+TapeDocument::TapeDocument()
+    : tape_(nullptr),
+      root_(&null_word, nullptr, nullptr) {
+}
+
+TapeDocument::TapeDocument(const Value& value)
+    : tape_(nullptr),
+      root_(&null_word, nullptr, nullptr) {
+    tape *result = new tape();
+    try {
+        format::writer out(result->words, result->strings, true);
+        write(value, out);
+    } catch (...) {
+        delete result;
+        throw;
+    }
+    result->own();
+    tape_ = result;
+    root_ = TapeValue(result->first, nullptr, result->pool);
+}
+
+TapeDocument::TapeDocument(tape *t)
+    : tape_(t),
+      root_(t->first, nullptr, t->pool) {
+}
+
+TapeDocument::TapeDocument(const TapeDocument& other)
+    : tape_(other.tape_),
+      root_(other.root_) {
+    if (tape_ != nullptr) {
+        tape_->refs.acquire();
+    }
+}
+
+TapeDocument::~TapeDocument() {
+    if (tape_ != nullptr && tape_->refs.release()) {
+        delete tape_;
+    }
+}
+
+TapeDocument& TapeDocument::operator=(const TapeDocument& other) {
+    TapeDocument copy(other);
+    std::swap(tape_, copy.tape_);
+    std::swap(root_, copy.root_);
+    return *this;
+}
+
+size_t TapeDocument::count() const {
+    return tape_ != nullptr ? tape_->count : 1;
+}
+
+size_t TapeDocument::memory() const {
+    if (tape_ == nullptr) {
+        return 0;
+    }
+    return sizeof(tape) + tape_->words.capacity() * sizeof(uint64_t) + tape_->strings.capacity() + tape_->snapshot.size();
+}
+
+TapeDocument parse_tape(const char *spec, size_t size) {
+    TapeDocument::tape *result = new TapeDocument::tape();
+    try {
+        detail::IO::parse_tape(result->words, result->strings, spec, size);
+    } catch (...) {
+        delete result;
+        throw;
+    }
+    result->own();
+    return TapeDocument(result);
+}
+
+TapeDocument parse_tape(const std::string& spec) {
+    return parse_tape(spec.data(), spec.size());
+}
+
+/*************/
+/* snapshots */
+/*************/
+
+static uint64_t checksum(const format::snapshot_header& header, const char *words, const char *strings) {
+    format::snapshot_header copy = header;
+    copy.checksum = 0;
+    uint64_t hash = format::checksum(0xcbf29ce484222325ULL, reinterpret_cast<const char*>(&copy), sizeof(copy));
+    hash = format::checksum(hash, words, static_cast<size_t>(header.words * sizeof(uint64_t)));
+    return format::checksum(hash, strings, static_cast<size_t>(header.strings));
+}
+
+void save_snapshot(const TapeDocument& document, const std::string& path) {
+    const TapeDocument::tape *t = document.tape_;
+    const uint64_t *words = t != nullptr ? t->first : &null_word;
+    const char *strings = t != nullptr ? t->pool : nullptr;
+
+    format::snapshot_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, format::snapshot_magic, sizeof(header.magic));
+    header.version = format::snapshot_version;
+    header.byte_order = format::byte_order_mark;
+    header.words = document.count();
+    header.strings = t != nullptr ? t->pool_size : 0;
+    header.checksum = checksum(header, reinterpret_cast<const char*>(words), strings);
+
+    // written aside, readers of the previous snapshot keep their mapping
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream stream(temporary.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(words), static_cast<std::streamsize>(header.words * sizeof(uint64_t)));
+        if (header.strings > 0) {
+            stream.write(strings, static_cast<std::streamsize>(header.strings));
+        }
+        stream.close();
+        if (!stream) {
+            std::remove(temporary.c_str());
+            throw snapshot_error("Unable to write file '" + temporary + "'");
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw snapshot_error("Unable to replace file '" + path + "'");
+    }
+}
+
+void save_snapshot(const Value& value, const std::string& path) {
+    save_snapshot(TapeDocument(value), path);
+}
+
+TapeDocument open_snapshot(const std::string& path, bool verify) {
+    TapeDocument::tape *result = new TapeDocument::tape();
+    try {
+        const char *data = nullptr;
+        size_t size = 0;
+        if (result->snapshot.open(path, detail::mapped_file::normal)) {
+            data = result->snapshot.data();
+            size = result->snapshot.size();
+        } else {
+            // no mmap, read into the (aligned) words instead
+            std::ifstream stream(path.c_str(), std::ios::in | std::ios::binary);
+            if (!stream) {
+                throw snapshot_error("Unable to open file '" + path + "'");
+            }
+            std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+            result->words.resize(content.size() / sizeof(uint64_t) + 1);
+            memcpy(&result->words[0], content.data(), content.size());
+            data = reinterpret_cast<const char*>(&result->words[0]);
+            size = content.size();
+        }
+
+        format::snapshot_header header;
+        if (size < sizeof(header)) {
+            throw snapshot_error("File '" + path + "' is not a snapshot");
+        }
+        memcpy(&header, data, sizeof(header));
+        if (memcmp(header.magic, format::snapshot_magic, sizeof(header.magic)) != 0) {
+            throw snapshot_error("File '" + path + "' is not a snapshot");
+        }
+        if (header.version != format::snapshot_version || header.byte_order != format::byte_order_mark) {
+            throw snapshot_error("File '" + path + "' was written by an incompatible version or machine");
+        }
+
+        const char *words = data + sizeof(header);
+        const char *strings = words + header.words * sizeof(uint64_t);
+        if (header.words == 0 || header.words > (size - sizeof(header)) / sizeof(uint64_t)
+                || header.strings != size - sizeof(header) - header.words * sizeof(uint64_t)) {
+            throw snapshot_error("File '" + path + "' is truncated");
+        }
+        if (verify && checksum(header, words, strings) != header.checksum) {
+            throw snapshot_error("File '" + path + "' is corrupted");
+        }
+
+        // the root spans the whole tape
+        const uint64_t *first = reinterpret_cast<const uint64_t*>(words);
+        if (format::width_of(*first) != header.words) {
+            throw snapshot_error("File '" + path + "' is corrupted");
+        }
+
+        result->first = first;
+        result->pool = header.strings > 0 ? strings : nullptr;
+        result->count = static_cast<size_t>(header.words);
+        result->pool_size = static_cast<size_t>(header.strings);
+    } catch (...) {
+        delete result;
+        throw;
+    }
+    return TapeDocument(result);
+}
+
+} // namespace json
@@ -6,13 +6,15 @@
  */
 
 #include "json/value.hpp"
+#include "json/detail/columns.hpp"
 
 #include "detail/json_io.hpp"
 #include <sstream>
+#include <utility>
 
 #define OBJECT_VALID_OR_THROW() do { \
     if (temp_flag_.is_temporary) { \
-        throw key_not_found(temp_flag_.temporary_key); \
+        throw key_not_found(value_.str_val); \
     } \
 } while (false)
 
@@ -36,6 +38,7 @@ namespace json {
 
 const json_spec_parse option_parse = {};
 const json_spec_force option_force = {};
+const json_spec_pack option_pack = {};
 const Value::json_spec_private Value::option_private = {};
 const Value Value::Null(option_private);
 
@@ -112,13 +115,56 @@ Value::Value(std::istream& stream)
     parse(stream);
 }
 
+Value::Value(const Value& other)
+    : type_(other.type_),
+      temp_flag_(other.temp_flag_),
+      value_(other.value_),
+      raw_(other.raw_) {
+}
+
+Value& Value::operator=(const Value& other) {
+    if (this != &other) {
+        Value copy(other); // `other` may be released along with the current content
+        assign(copy);
+    }
+    return *this;
+}
+
 #if JSON_HAVE_CXX11
+Value::Value(Value&& other) noexcept
+    : type_(other.type_),
+      temp_flag_(other.temp_flag_),
+      value_(std::move(other.value_)),
+      raw_(other.raw_) {
+    other.lookups_.clear(); // the indexes point to children now owned by this one
+}
+
+Value& Value::operator=(Value&& other) {
+    if (this != &other) {
+        Value moved(std::move(other)); // `other` may be released along with the current content
+        assign(moved);
+    }
+    return *this;
+}
+
 Value::Value(std::initializer_list<std::pair<const std::string, Value>> childs)
     : type_{Type::Object} {
-    value_.map_val.insert(childs);
+    value_.map_val.write().insert(childs);
 }
 #endif
 
+void Value::assign(Value& other) {
+    lookups_.clear();
+    type_ = other.type_;
+    temp_flag_ = other.temp_flag_;
+#if JSON_HAVE_CXX11
+    value_ = std::move(other.value_);
+#else
+    value_ = other.value_;
+#endif
+    raw_ = other.raw_;
+}
+
 /***********************/
 /* private contructors */
 /***********************/
@@ -129,7 +175,15 @@ Value::Value(const json_spec_private&)
 
 Value::Value(const json_spec_private&, const std::string& key)
     : type_(Type::Object),
-      temp_flag_(key) {
+      temp_flag_(true),
+      value_(key) {
+}
+
+void Value::fill_placeholder() {
+    if (temp_flag_.is_temporary) {
+        temp_flag_.is_temporary = false;
+        std::string().swap(value_.str_val); // the key, not needed anymore
+    }
 }
 
 /****************************/
@@ -143,11 +197,15 @@ Type::Value Value::type() const {
 
 bool Value::empty() const {
     OBJECT_VALID_OR_THROW();
+    if (is_packed()) {
+        return false; // empty arrays are not packed
+    }
+    expand();
     switch (type_) {
         case Type::Object:
-            return value_.map_val.empty();
+            return value_.map_val->empty();
         case Type::Array:
-            return value_.arr_val.empty();
+            return value_.arr_val->empty();
         default:
             return false;
     }
@@ -155,11 +213,15 @@ bool Value::empty() const {
 
 size_t Value::size() const {
     OBJECT_VALID_OR_THROW();
+    if (is_packed()) {
+        return raw_.kind() == detail::raw_text::column_table ? raw_.table().rows : raw_.count();
+    }
+    expand();
     switch (type_) {
         case Type::Object:
-            return value_.map_val.size();
+            return value_.map_val->size();
         case Type::Array:
-            return value_.arr_val.size();
+            return value_.arr_val->size();
         default:
             throw bad_json_type(static_cast<Type::Value>(Type::Array|Type::Object), type_);
     }
@@ -173,7 +235,7 @@ bool Value::exists(const key_type& key) const {
 bool Value::exists(const Pointer &pointer) const {
     OBJECT_VALID_OR_THROW();
     TYPE_VALID_OR_THROW_EX(Type::Object, this->empty());
-    return pointer.is_valid_for(*this);
+    return find(pointer) != nullptr;
 }
 
 bool Value::to_bool() const {
@@ -223,14 +285,63 @@ std::string Value::to_string(const json_spec_force&) const {
 
 const Value::array_type& Value::to_array() const {
     OBJECT_VALID_OR_THROW();
+    expand();
     TYPE_VALID_OR_THROW_EX(Type::Array, this->empty()); // accept empty objects
-    return value_.arr_val;
+    return *value_.arr_val;
 }
 
 const Value::map_type& Value::to_map() const {
     OBJECT_VALID_OR_THROW();
+    expand();
     TYPE_VALID_OR_THROW_EX(Type::Object, this->empty()); // accept empty objects
-    return value_.map_val;
+    return *value_.map_val;
+}
+
+/* the column `key` of the array packed in `raw`, which must have the given storage */
+static const detail::columns::column& column_of(const detail::raw_text& raw,
+                                                const Value::key_type& key,
+                                                detail::columns::column::storage kind,
+                                                Type::Value type) {
+    if (raw.kind() != detail::raw_text::column_table) {
+        throw bad_json_type(type, Type::Array);
+    }
+    const detail::columns::column *col = raw.table().find(key);
+    if (col == nullptr) {
+        throw key_not_found(key);
+    }
+    if (col->kind != kind) {
+        static const Type::Value types[] = { Type::Integer, Type::Double, Type::String };
+        throw bad_json_type(type, col->kind == detail::columns::column::values ? col->any_vals.front().type() : types[col->kind]);
+    }
+    return *col;
+}
+
+span<const int64_t> Value::to_int_column(const key_type& key) const {
+    OBJECT_VALID_OR_THROW();
+    const detail::columns::column& col = column_of(raw_, key, detail::columns::column::ints, Type::Integer);
+    return span<const int64_t>(&col.int_vals[0], col.int_vals.size());
+}
+
+span<const double> Value::to_double_column(const key_type& key) const {
+    OBJECT_VALID_OR_THROW();
+    const detail::columns::column& col = column_of(raw_, key, detail::columns::column::dbls, Type::Double);
+    return span<const double>(&col.dbl_vals[0], col.dbl_vals.size());
+}
+
+span<const int64_t> Value::to_int_span() const {
+    OBJECT_VALID_OR_THROW();
+    if (raw_.kind() != detail::raw_text::packed_int) {
+        throw bad_json_type(Type::Integer, raw_.kind() == detail::raw_text::packed_double ? Type::Double : type_);
+    }
+    return span<const int64_t>(raw_.values<int64_t>(), raw_.count());
+}
+
+span<const double> Value::to_double_span() const {
+    OBJECT_VALID_OR_THROW();
+    if (raw_.kind() != detail::raw_text::packed_double) {
+        throw bad_json_type(Type::Double, raw_.kind() == detail::raw_text::packed_int ? Type::Integer : type_);
+    }
+    return span<const double>(raw_.values<double>(), raw_.count());
 }
 
 /**********************************/
@@ -238,45 +349,54 @@ const Value::map_type& Value::to_map() const {
 /**********************************/
 
 Value::iterator Value::begin() {
+    lookups_.clear();
+    expand();
     TYPE_VALID_OR_THROW_EX(Type::Object, this->empty());
     if (type_ != Type::Object) {
         type_ = Type::Object; // change type from array to object
     }
-    return value_.map_val.begin();
+    return value_.map_val.leak().begin();
 }
 
 Value::const_iterator Value::begin() const {
+    expand();
     TYPE_VALID_OR_THROW_EX(Type::Object, this->empty());
-    return value_.map_val.begin();
+    return value_.map_val->begin();
 }
 
 Value::iterator Value::end() {
+    lookups_.clear();
+    expand();
     TYPE_VALID_OR_THROW_EX(Type::Object, this->empty());
     if (type_ != Type::Object) {
         type_ = Type::Object; // change type from array to object
     }
-    return value_.map_val.end();
+    return value_.map_val.leak().end();
 }
 
 Value::const_iterator Value::end() const {
+    expand();
     TYPE_VALID_OR_THROW_EX(Type::Object, this->empty());
-    return value_.map_val.end();
+    return value_.map_val->end();
 }
 
 Value::iterator Value::find(const key_type& key) {
+    lookups_.clear();
+    expand();
     TYPE_VALID_OR_THROW_EX(Type::Object, this->empty());
     if (type_ != Type::Object) {
         type_ = Type::Object; // change type from array to object
     }
-    return value_.map_val.find(key);
+    return value_.map_val.leak().find(key);
 }
 
 Value::const_iterator Value::find(const key_type& key) const {
+    expand();
     TYPE_VALID_OR_THROW_EX(Type::Object, this->empty());
     if (type_ != Type::Object) {
-        return value_.map_val.end();
+        return value_.map_val->end();
     }
-    return value_.map_val.find(key);
+    return value_.map_val->find(key);
 }
 
 Value& Value::operator[](const key_type& key) {
@@ -287,11 +407,8 @@ Value& Value::operator[](const key_type& key) {
 
     // object not found, but this method is not const so the object
     // must be inserted in the map, this allows to build JSON object
-    std::pair<iterator, bool> ret = value_.map_val.insert(std::make_pair(key, Value(option_private, key)));
-    if (temp_flag_.is_temporary) {
-        temp_flag_.is_temporary = false;
-        temp_flag_.temporary_key = "";
-    }
+    std::pair<iterator, bool> ret = value_.map_val.leak().insert(std::make_pair(key, Value(option_private, key)));
+    fill_placeholder();
 
     return ret.first->second;
 }
@@ -305,80 +422,200 @@ const Value& Value::operator[](const key_type& key) const {
 }
 
 void Value::erase(const key_type& key) {
-    iterator it = find(key);
-    if (it != end()) {
-        value_.map_val.erase(it);
+    lookups_.clear();
+    expand();
+    TYPE_VALID_OR_THROW_EX(Type::Object, this->empty());
+    if (type_ != Type::Object) {
+        type_ = Type::Object; // change type from array to object
+    }
+    if (value_.map_val->count(key) != 0) { // a shared map is copied only if there is something to erase
+        value_.map_val.write().erase(key);
     }
 }
 
 Value::array_iterator Value::abegin() {
+    lookups_.clear();
+    expand();
     TYPE_VALID_OR_THROW_EX(Type::Array, this->empty());
     if (type_ != Type::Array) {
         type_ = Type::Array; // change type from object to array
     }
-    return value_.arr_val.begin();
+    return value_.arr_val.leak().begin();
 }
 
 Value::const_array_iterator Value::abegin() const {
+    expand();
     TYPE_VALID_OR_THROW_EX(Type::Array, this->empty());
-    return value_.arr_val.begin();
+    return value_.arr_val->begin();
 }
 
 Value::array_iterator Value::aend() {
+    lookups_.clear();
+    expand();
     TYPE_VALID_OR_THROW_EX(Type::Array, this->empty());
     if (type_ != Type::Array) {
         type_ = Type::Array; // change type from object to array
     }
-    return value_.arr_val.end();
+    return value_.arr_val.leak().end();
 }
 
 Value::const_array_iterator Value::aend() const {
+    expand();
     TYPE_VALID_OR_THROW_EX(Type::Array, this->empty());
-    return value_.arr_val.end();
+    return value_.arr_val->end();
 }
 
 const Value& Value::operator[](size_t idx) const {
+    expand();
     TYPE_VALID_OR_THROW(Type::Array);
-    return value_.arr_val.at(idx);
+    return value_.arr_val->at(idx);
 }
 
 Value& Value::operator[](size_t idx) {
+    lookups_.clear();
+    expand();
     TYPE_VALID_OR_THROW(Type::Array);
-    return value_.arr_val.at(idx);
+    return value_.arr_val.leak().at(idx);
 }
 
 Value& Value::push_back(const Value& val) {
-    bool was_empty = value_.arr_val.empty();
+    lookups_.clear();
+    expand();
+    bool was_empty = value_.arr_val->empty();
     TYPE_VALID_OR_THROW_EX(Type::Array, (temp_flag_.is_temporary || was_empty));
 
-    value_.arr_val.push_back(val);
+    array_type& array = value_.arr_val.leak(); // if copied, `val` stays in the shared array
+    array.push_back(val);
 
     if (temp_flag_.is_temporary || was_empty) {
     // user is building a nested json object
         type_ = Type::Array;
-        temp_flag_.is_temporary = false;
-        temp_flag_.temporary_key = "";
+        fill_placeholder();
+    }
+
+    return array.back();
+}
+
+Value& Value::merge_patch(const Value& patch) {
+    if (patch.temp_flag_.is_temporary) { // this one may be a new member, but not the patch
+        throw key_not_found(patch.value_.str_val);
+    }
+    patch.expand();
+    if (patch.type_ != Type::Object) {
+        return *this = patch;
+    }
+
+    expand();
+    lookups_.clear();
+    if (type_ != Type::Object || temp_flag_.is_temporary) {
+        *this = Value();
+    }
+
+    map_type& map = value_.map_val.write();
+    for (const_iterator it = patch.value_.map_val->begin(), end = patch.value_.map_val->end(); it != end; ++it) {
+        if (it->second.type_ == Type::Null) {
+            map.erase(it->first);
+        } else {
+            map[it->first].merge_patch(it->second);
+        }
+    }
+
+    return *this;
+}
+
+#if JSON_HAVE_CXX11
+Value& Value::merge_patch(Value&& patch) {
+    if (patch.temp_flag_.is_temporary) { // this one may be a new member, but not the patch
+        throw key_not_found(patch.value_.str_val);
+    }
+    patch.expand();
+    if (patch.type_ != Type::Object) {
+        return *this = std::move(patch);
+    }
+
+    expand();
+    lookups_.clear();
+    if (type_ != Type::Object || temp_flag_.is_temporary) {
+        *this = Value();
+    }
+
+    map_type& map = value_.map_val.write();
+    map_type& members = patch.value_.map_val.write();
+    for (iterator it = members.begin(), end = members.end(); it != end; ++it) {
+        if (it->second.type_ == Type::Null) {
+            map.erase(it->first);
+        } else {
+            map[it->first].merge_patch(std::move(it->second));
+        }
     }
 
-    return value_.arr_val.back();
+    return *this;
 }
+#endif
 
 void Value::append(const array_type& a) {
     append(a.begin(), a.end());
 }
 
 void Value::append(const_array_iterator ibegin, const_array_iterator iend) {
-    bool was_empty = value_.arr_val.empty();
+    lookups_.clear();
+    expand();
+    bool was_empty = value_.arr_val->empty();
     TYPE_VALID_OR_THROW_EX(Type::Array, (temp_flag_.is_temporary || was_empty));
 
-    value_.arr_val.insert(value_.arr_val.end(), ibegin, iend);
+    array_type& array = value_.arr_val.write(); // if copied, the range stays in the shared array
+    array.insert(array.end(), ibegin, iend);
 
     if (temp_flag_.is_temporary || was_empty) {
     // user is building a nested json object
         type_ = Type::Array;
-        temp_flag_.is_temporary = false;
-        temp_flag_.temporary_key = "";
+        fill_placeholder();
+    }
+}
+
+bool Value::pack() {
+    OBJECT_VALID_OR_THROW();
+    if (is_packed()) {
+        return true;
+    }
+    expand();
+    if (type_ != Type::Array || value_.arr_val->empty()) {
+        return false;
+    }
+
+    const array_type& array = *value_.arr_val;
+    Type::Value type = array.front().type_;
+    for (const_array_iterator it = array.begin(), end = array.end(); it != end && type != Type::Null; ++it) {
+        if (it->type_ != type) {
+            type = Type::Null; // mixed
+        }
+    }
+
+    if (type == Type::Integer) {
+        std::vector<int64_t> values;
+        values.reserve(array.size());
+        for (const_array_iterator it = array.begin(), end = array.end(); it != end; ++it) {
+            values.push_back(it->value_.int_val);
+        }
+        raw_ = detail::raw_text(values);
+    } else if (type == Type::Double) {
+        std::vector<double> values;
+        values.reserve(array.size());
+        for (const_array_iterator it = array.begin(), end = array.end(); it != end; ++it) {
+            values.push_back(it->value_.dbl_val);
+        }
+        raw_ = detail::raw_text(values);
+    } else {
+        detail::columns *table = detail::columns::build(array);
+        if (table == nullptr) {
+            return false;
+        }
+        raw_ = detail::raw_text(table);
     }
+
+    lookups_.clear();
+    value_.arr_val = detail::copy_on_write<array_type>();
+    return true;
 }
 
 const Value& Value::operator[](const Pointer& pointer) const {
@@ -386,6 +623,59 @@ const Value& Value::operator[](const Pointer& pointer) const {
     return pointer.get_reference(*this);
 }
 
+const Value *Value::find(const Pointer& pointer) const {
+    OBJECT_VALID_OR_THROW();
+    return pointer.find(*this);
+}
+
+Value *Value::find(const Pointer& pointer) {
+    OBJECT_VALID_OR_THROW();
+    if (pointer.find(*this) == nullptr) {
+        return nullptr;
+    }
+    return &pointer.get_or_create(*this); // copies the shared containers along the path
+}
+
+Value& Value::at_or_create(const Pointer& pointer) {
+    OBJECT_VALID_OR_THROW();
+    return pointer.get_or_create(*this);
+}
+
+Value& Value::set(const Pointer& pointer, const Value& val) {
+    Value copy(val); // `val` may live within this JSON
+#if JSON_HAVE_CXX11
+    return set(pointer, std::move(copy));
+#else
+    return at_or_create(pointer) = copy;
+#endif
+}
+
+Value& Value::insert(const Pointer& pointer, const Value& val) {
+    Value copy(val); // `val` may live within this JSON
+#if JSON_HAVE_CXX11
+    return insert(pointer, std::move(copy));
+#else
+    OBJECT_VALID_OR_THROW();
+    return pointer.insert_into(*this) = copy;
+#endif
+}
+
+#if JSON_HAVE_CXX11
+Value& Value::set(const Pointer& pointer, Value&& val) {
+    return at_or_create(pointer) = std::move(val);
+}
+
+Value& Value::insert(const Pointer& pointer, Value&& val) {
+    OBJECT_VALID_OR_THROW();
+    return pointer.insert_into(*this) = std::move(val);
+}
+#endif
+
+bool Value::erase(const Pointer& pointer) {
+    OBJECT_VALID_OR_THROW();
+    return pointer.erase_from(*this);
+}
+
 template<> bool Value::get_optional<bool>(const key_type& key, const bool &default_value) const {
     return exists(key) && !at(key).is_null() ? at(key).to_bool() : default_value;
 }
@@ -457,9 +747,113 @@ bool Value::operator==(const Value& other) const {
         case Type::String:
             return value_.str_val == other.value_.str_val;
         default:
-            // object or arrays are different even when
-            //having the same structure with the same values
-            return false;
+            return equals(other, -1); // containers, no tolerance (and no mixed numbers)
+    }
+}
+
+bool Value::equals(const Value& other, double epsilon) const {
+    OBJECT_VALID_OR_THROW();
+    if (this == &other) {
+        return true;
+    }
+
+    bool numbers = (type_ & (Type::Integer|Type::Double)) && (other.type_ & (Type::Integer|Type::Double));
+    if (numbers && epsilon >= 0) {
+        if (type_ == Type::Integer && other.type_ == Type::Integer) {
+            uint64_t lhs = static_cast<uint64_t>(value_.int_val), rhs = static_cast<uint64_t>(other.value_.int_val);
+            uint64_t diff = value_.int_val > other.value_.int_val ? lhs - rhs : rhs - lhs;
+            return static_cast<double>(diff) <= epsilon;
+        }
+        double diff = to_double() - other.to_double();
+        return (diff < 0 ? -diff : diff) <= epsilon;
+    }
+
+    expand();
+    other.expand();
+    if (type_ != other.type_) {
+        return false;
+    }
+
+    switch (type_) {
+        case Type::Array: {
+            if (value_.arr_val->size() != other.value_.arr_val->size()) {
+                return false;
+            }
+            for (size_t i = 0, size = value_.arr_val->size(); i < size; ++i) {
+                if (!(*value_.arr_val)[i].equals((*other.value_.arr_val)[i], epsilon)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case Type::Object: {
+            if (value_.map_val->size() != other.value_.map_val->size()) {
+                return false;
+            }
+            for (const_iterator l = value_.map_val->begin(), r = other.value_.map_val->begin(), end = value_.map_val->end();
+                    l != end;
+                    ++l, ++r) {
+                if (l->first != r->first || !l->second.equals(r->second, epsilon)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            return *this == other;
+    }
+}
+
+int Value::compare(const Value& other) const {
+    OBJECT_VALID_OR_THROW();
+    if (this == &other) {
+        return 0;
+    }
+
+    expand();
+    other.expand();
+    if (type_ != other.type_) {
+        return type_ < other.type_ ? -1 : 1;
+    }
+
+    switch (type_) {
+        case Type::Null:
+            return 0;
+        case Type::Boolean:
+            return static_cast<int>(value_.bool_val) - static_cast<int>(other.value_.bool_val);
+        case Type::Integer:
+            return value_.int_val < other.value_.int_val ? -1 : (other.value_.int_val < value_.int_val ? 1 : 0);
+        case Type::Double: {
+            // NaN is equal to itself and less than any other number, for the order to be total
+            bool nan = value_.dbl_val != value_.dbl_val, other_nan = other.value_.dbl_val != other.value_.dbl_val;
+            if (nan || other_nan) {
+                return static_cast<int>(other_nan) - static_cast<int>(nan);
+            }
+            return value_.dbl_val < other.value_.dbl_val ? -1 : (other.value_.dbl_val < value_.dbl_val ? 1 : 0);
+        }
+        case Type::String:
+            return value_.str_val.compare(other.value_.str_val);
+        case Type::Array: {
+            const_array_iterator l = value_.arr_val->begin(), r = other.value_.arr_val->begin();
+            for (; l != value_.arr_val->end() && r != other.value_.arr_val->end(); ++l, ++r) {
+                if (int result = l->compare(*r)) {
+                    return result;
+                }
+            }
+            return l == value_.arr_val->end() ? (r == other.value_.arr_val->end() ? 0 : -1) : 1;
+        }
+        default: {
+            const_iterator l = value_.map_val->begin(), r = other.value_.map_val->begin();
+            for (; l != value_.map_val->end() && r != other.value_.map_val->end(); ++l, ++r) {
+                if (int result = l->first.compare(r->first)) {
+                    return result;
+                }
+                if (int result = l->second.compare(r->second)) {
+                    return result;
+                }
+            }
+            return l == value_.map_val->end() ? (r == other.value_.map_val->end() ? 0 : -1) : 1;
+        }
     }
 }
 
@@ -468,6 +862,14 @@ bool Value::operator!=(const Value& other) const {
     return !(*this == other);
 }
 
+/******************/
+/* lazy decoding */
+/******************/
+
+void Value::expand_lazy() const {
+    detail::IO::expand(const_cast<Value&>(*this));
+}
+
 /***********************/
 /* json input / output */
 /***********************/
@@ -503,12 +905,14 @@ Value& Value::parse(const char *spec, size_t size) {
 }
 
 Value& Value::parse(const std::string& spec) {
+    lookups_.clear();
     detail::IO::parse(*this, spec);
     return *this;
 }
 
 Value& Value::parse(std::istream& stream) {
-    detail::IO::parse(*this, stream);
+    lookups_.clear();
+    detail::IO::parse(*this, stream, false);
     return *this;
 }
 
@@ -525,6 +929,58 @@ Value parse(std::istream& stream) {
     return Value(stream);
 }
 
+Value parse(const char *spec, size_t size, const json_spec_pack&) {
+    Value val;
+    detail::IO::parse(val, spec, size, true);
+    return val;
+}
+
+Value parse(const std::string& spec, const json_spec_pack&) {
+    return parse(spec.data(), spec.size(), option_pack);
+}
+
+Value parse(const char *spec, size_t size, const std::vector<Pointer>& raw) {
+    Value val;
+    detail::IO::parse_raw(val, spec, size, raw);
+    return val;
+}
+
+Value parse(const std::string& spec, const std::vector<Pointer>& raw) {
+    return parse(spec.data(), spec.size(), raw);
+}
+
+Value parse_lazy(const char *spec, size_t size) {
+    Value val;
+    detail::IO::parse_lazy(val, spec, size);
+    return val;
+}
+
+Value parse_lazy(const std::string& spec) {
+    return parse_lazy(spec.data(), spec.size());
+}
+
+Value parse_file(const std::string& path) {
+    Value val;
+    detail::IO::parse_file(val, path, false);
+    return val;
+}
+
+Value parse_file(const std::string& path, const json_spec_pack&) {
+    Value val;
+    detail::IO::parse_file(val, path, true);
+    return val;
+}
+
+Value parse_parallel(const char *spec, size_t size, unsigned int threads) {
+    Value val;
+    detail::IO::parse_parallel(val, spec, size, threads);
+    return val;
+}
+
+Value parse_parallel(const std::string& spec, unsigned int threads) {
+    return parse_parallel(spec.data(), spec.size(), threads);
+}
+
 std::istream& operator>>(std::istream& stream, Value& jsonval) {
     jsonval.parse(stream);
     return stream;
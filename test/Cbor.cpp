@@ -0,0 +1,153 @@
+/*!
+ * \file Cbor.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include <gtest/gtest.h>
+
+#include <json.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+static std::string to_hex(const std::vector<uint8_t>& bytes) {
+    static const char digits[] = "0123456789abcdef";
+    std::string result;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        result += digits[bytes[i] >> 4];
+        result += digits[bytes[i] & 0xf];
+    }
+    return result;
+}
+
+static std::vector<uint8_t> from_hex(const std::string& hex) {
+    std::vector<uint8_t> result;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        result.push_back(static_cast<uint8_t>(strtoul(hex.substr(i, 2).c_str(), nullptr, 16)));
+    }
+    return result;
+}
+
+static std::string encode(const std::string& spec) {
+    // wrapped, the text parser takes objects and arrays only
+    return to_hex(json::to_cbor(json::parse("[" + spec + "]")[0]));
+}
+
+static std::string decode(const std::string& hex) {
+    return json::from_cbor(from_hex("81" + hex)).stringify(); // wrapped in an array too
+}
+
+TEST(JSON_Cbor, Encode) {
+    // RFC 8949, appendix A
+    ASSERT_EQ("00", encode("0"));
+    ASSERT_EQ("17", encode("23"));
+    ASSERT_EQ("1818", encode("24"));
+    ASSERT_EQ("1864", encode("100"));
+    ASSERT_EQ("1903e8", encode("1000"));
+    ASSERT_EQ("1a000f4240", encode("1000000"));
+    ASSERT_EQ("1b000000e8d4a51000", encode("1000000000000"));
+    ASSERT_EQ("20", encode("-1"));
+    ASSERT_EQ("3863", encode("-100"));
+    ASSERT_EQ("3903e7", encode("-1000"));
+    ASSERT_EQ("3b7fffffffffffffff", to_hex(json::to_cbor(Json(std::numeric_limits<int64_t>::min()))));
+    ASSERT_EQ("fa47c35000", encode("100000.0"));
+    ASSERT_EQ("fb3ff199999999999a", encode("1.1"));
+    ASSERT_EQ("fb7e37e43c8800759c", encode("1e300"));  // out of float range
+    ASSERT_EQ("fbc8078287f49c4a1d", encode("-1e39"));
+    ASSERT_EQ("f4", encode("false"));
+    ASSERT_EQ("f5", encode("true"));
+    ASSERT_EQ("f6", encode("null"));
+    ASSERT_EQ("60", encode("\"\""));
+    ASSERT_EQ("6449455446", encode("\"IETF\""));
+    ASSERT_EQ("80", encode("[]"));
+    ASSERT_EQ("83010203", encode("[1,2,3]"));
+    ASSERT_EQ("a0", encode("{}"));
+    ASSERT_EQ("a26161016162820203", encode("{\"a\":1,\"b\":[2,3]}"));
+
+    // appended to the buffer
+    std::vector<uint8_t> out(1, 0x82);
+    json::to_cbor(Json(1), out);
+    json::to_cbor(Json("a"), out);
+    ASSERT_EQ("82016161", to_hex(out));
+}
+
+TEST(JSON_Cbor, Decode) {
+    ASSERT_EQ("[1000000000000]", decode("1b000000e8d4a51000"));
+    ASSERT_EQ("[-1000]", decode("3903e7"));
+    ASSERT_EQ("[1.500000]", decode("f93e00"));
+    ASSERT_EQ("[-4.000000]", decode("f9c400"));
+    ASSERT_EQ(6.103515625e-05, json::from_cbor(from_hex("f90400")).to_double());
+    ASSERT_EQ(100000.0, json::from_cbor(from_hex("fa47c35000")).to_double());
+    ASSERT_EQ(1.1, json::from_cbor(from_hex("fb3ff199999999999a")).to_double());
+    ASSERT_EQ("[null]", decode("f7")); // undefined
+
+    // indefinite lengths
+    ASSERT_EQ("[[]]", decode("9fff"));
+    ASSERT_EQ("[[1,[2,3],[4,5]]]", decode("9f018202039f0405ffff"));
+    ASSERT_EQ("[{\"a\":1,\"b\":[2,3]}]", decode("bf61610161629f0203ffff"));
+    ASSERT_EQ("[\"streaming\"]", decode("7f657374726561646d696e67ff"));
+
+    // tags are skipped, byte strings are strings
+    ASSERT_EQ("[\"2013-03-21T20:04:00Z\"]", decode("c074323031332d30332d32315432303a30343a30305a"));
+    ASSERT_EQ("[\"IETF\"]", decode("4449455446"));
+
+    ASSERT_EQ(Json("IETF"), json::from_cbor(from_hex("6449455446")));
+    ASSERT_EQ(Json(json::Value::array_type()), json::from_cbor(from_hex("80")));
+}
+
+TEST(JSON_Cbor, RoundTrip) {
+    std::ifstream stream("test/samples/1.glossary.json");
+    std::stringstream sample;
+    sample << stream.rdbuf();
+
+    Json value = json::parse(sample.str());
+    std::vector<uint8_t> encoded = json::to_cbor(value);
+    ASSERT_LT(encoded.size(), value.stringify().size());
+    ASSERT_EQ(value, json::from_cbor(encoded));
+
+    // packed arrays are encoded as they are
+    std::string records = "[";
+    for (int i = 0; i < 100; ++i) {
+        records += (i > 0 ? "," : "") + std::string("{\"id\":") + std::to_string(i) + ",\"ratio\":" + std::to_string(i / 4.0) + "}";
+    }
+    records += "]";
+    Json packed = json::parse("{\"records\":" + records + ",\"ints\":[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16]}",
+                              json::option_pack);
+    ASSERT_TRUE(packed["records"].is_packed());
+
+    Json decoded = json::from_cbor(json::to_cbor(packed));
+    ASSERT_FALSE(decoded["records"].is_packed());
+    ASSERT_EQ(packed.stringify(), decoded.stringify());
+
+    // lazy values are encoded as if decoded
+    ASSERT_EQ(json::to_cbor(value), json::to_cbor(json::parse_lazy(sample.str())));
+}
+
+TEST(JSON_Cbor, Malformed) {
+    ASSERT_THROW(json::from_cbor(std::vector<uint8_t>()), json::parse_error);
+    ASSERT_THROW(json::from_cbor(from_hex("830102")), json::parse_error);             // truncated
+    ASSERT_THROW(json::from_cbor(from_hex("6449455")), json::parse_error);            // truncated string
+    ASSERT_THROW(json::from_cbor(from_hex("0102")), json::parse_error);               // two items
+    ASSERT_THROW(json::from_cbor(from_hex("a10102")), json::parse_error);             // integer key
+    ASSERT_THROW(json::from_cbor(from_hex("1bffffffffffffffff")), json::parse_error); // out of range
+    ASSERT_THROW(json::from_cbor(from_hex("ff")), json::parse_error);                 // unexpected break
+    ASSERT_THROW(json::from_cbor(from_hex("1c")), json::parse_error);                 // reserved
+    ASSERT_THROW(json::from_cbor(from_hex("7f01ff")), json::parse_error);             // bad chunk
+    ASSERT_THROW(json::from_cbor(from_hex("f8ff")), json::parse_error);               // simple value
+    ASSERT_THROW(json::from_cbor(from_hex("f97e00")), json::parse_error);             // NaN
+    ASSERT_THROW(json::from_cbor(from_hex("f9fc00")), json::parse_error);             // -Infinity
+    ASSERT_THROW(json::from_cbor(from_hex("fa7f800000")), json::parse_error);         // Infinity
+    ASSERT_THROW(json::from_cbor(from_hex("fb7ff8000000000000")), json::parse_error); // NaN
+    ASSERT_THROW(json::from_cbor(from_hex("82fb7ff000000000000001")), json::parse_error);
+
+    std::vector<uint8_t> deep(2000, 0x81);
+    deep.push_back(0x00);
+    ASSERT_THROW(json::from_cbor(deep), json::parse_error);
+
+    // huge lengths are not trusted
+    ASSERT_THROW(json::from_cbor(from_hex("9b7fffffffffffffff")), json::parse_error);
+}
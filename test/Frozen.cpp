@@ -0,0 +1,258 @@
+/*!
+ * \file Frozen.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include <gtest/gtest.h>
+
+#include <json.hpp>
+
+#include <atomic>
+#include <thread>
+
+static const char *spec =
+    "{\"name\":\"routes\",\"version\":3,\"ratio\":0.5,\"enabled\":true,\"none\":null,"
+    "\"routes\":[{\"id\":1,\"path\":\"/a\"},{\"id\":2,\"path\":\"/b\",\"tags\":[]}],\"empty\":{}}";
+
+TEST(JSON_Frozen, Scalars) {
+    json::FrozenDocument doc = json::freeze(json::parse(spec));
+    const json::FrozenValue& root = *doc;
+
+    ASSERT_TRUE(root.is_object());
+    ASSERT_EQ(7u, root.size());
+    ASSERT_EQ("routes", root["name"].to_string());
+    ASSERT_STREQ("routes", root["name"].c_str());
+    ASSERT_EQ(3, root["version"].to_int());
+    ASSERT_EQ(3.0, root["version"].to_double());
+    ASSERT_EQ(0.5, root["ratio"].to_double());
+    ASSERT_TRUE(root["enabled"].to_bool());
+    ASSERT_TRUE(root["none"].is_null());
+    ASSERT_TRUE(root["empty"].empty());
+
+    ASSERT_THROW(root["name"].to_int(), json::bad_json_type);
+    ASSERT_THROW(root["version"].size(), json::bad_json_type);
+    ASSERT_THROW(root["missing"], json::key_not_found);
+    ASSERT_THROW(root["routes"][2], std::out_of_range);
+    ASSERT_THROW(root["name"]["x"], json::bad_json_type);
+    ASSERT_EQ(nullptr, root.find("missing"));
+    ASSERT_EQ(nullptr, root["name"].find("x"));
+    ASSERT_TRUE(root.exists("ratio"));
+}
+
+TEST(JSON_Frozen, Navigation) {
+    json::FrozenDocument doc(json::parse(spec));
+
+    ASSERT_EQ("/b", doc->at(json::Pointer("/routes/1/path")).to_string());
+    ASSERT_EQ("/b", doc->at(json::Pointer("/routes/id=2/path")).to_string());
+    ASSERT_THROW(doc->find(json::Pointer("/routes/id=3")), json::parse_error); // as with Value
+    ASSERT_EQ(nullptr, doc->find(json::Pointer("/routes/5")));
+    ASSERT_THROW(doc->at(json::Pointer("/routes/5")), json::key_not_found);
+    ASSERT_THROW(doc->find(json::Pointer("/routes/01")), json::parse_error);
+
+    std::string keys;
+    for (const json::FrozenValue *it = doc->begin(); it != doc->end(); ++it) {
+        keys += it->key() + " ";
+    }
+    ASSERT_EQ("empty enabled name none ratio routes version ", keys);
+
+    int64_t ids = 0;
+    const json::FrozenValue& routes = (*doc)["routes"];
+    for (const json::FrozenValue *it = routes.begin(); it != routes.end(); ++it) {
+        ids += (*it)["id"].to_int();
+        ASSERT_EQ("", it->key());
+    }
+    ASSERT_EQ(3, ids);
+}
+
+TEST(JSON_Frozen, Thaw) {
+    Json value = json::parse(spec);
+    json::FrozenDocument doc(value);
+
+    ASSERT_EQ(value, doc->thaw());
+    ASSERT_EQ(value.stringify(), doc->stringify());
+    ASSERT_EQ(value["routes"][1].stringify(), (*doc)["routes"][1].stringify());
+
+    // the snapshot does not change along with the value
+    value["name"] = "changed";
+    ASSERT_EQ("routes", (*doc)["name"].to_string());
+
+    json::FrozenDocument null_doc;
+    ASSERT_TRUE(null_doc->is_null());
+    ASSERT_EQ(1u, null_doc.count());
+    ASSERT_EQ(15u, doc.count());
+
+    Json placeholder;
+    placeholder["missing"];
+    ASSERT_THROW(json::freeze(placeholder), json::key_not_found);
+}
+
+TEST(JSON_Frozen, ConcurrentReaders) {
+    Json value;
+    for (int i = 0; i < 1000; ++i) {
+        Json& route = value["routes"].push_back(Json());
+        route["id"] = i;
+        route["path"] = "/route/" + std::to_string(i);
+    }
+    const json::FrozenDocument doc(value);
+
+    std::vector<int64_t> sums(8);
+    std::vector<std::thread> readers;
+    for (size_t t = 0; t < sums.size(); ++t) {
+        readers.push_back(std::thread([&doc, &sums, t]() {
+            json::FrozenDocument mine = doc; // copies share the snapshot
+            for (int i = 0; i < 1000; ++i) {
+                const json::FrozenValue *route = mine->find(json::Pointer("/routes/id=" + std::to_string(i)));
+                sums[t] += (*route)["id"].to_int();
+            }
+        }));
+    }
+    for (size_t t = 0; t < readers.size(); ++t) {
+        readers[t].join();
+    }
+    for (size_t t = 0; t < sums.size(); ++t) {
+        ASSERT_EQ(999 * 1000 / 2, sums[t]);
+    }
+}
+
+TEST(JSON_Frozen, InternedKeys) {
+    const char *keys[] = { "id", "name", "enabled", "created_at", "updated_at",
+                           "owner", "group", "priority", "weight", "description" };
+    Json value;
+    for (int i = 0; i < 10000; ++i) {
+        Json& item = value["items"].push_back(Json());
+        for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); ++k) {
+            item[keys[k]] = i;
+        }
+    }
+    json::FrozenDocument doc(value);
+
+    // the pool has one copy of each key (and "items"), not one per object
+    size_t key_bytes = 6;
+    for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); ++k) {
+        key_bytes += strlen(keys[k]) + 1;
+    }
+    ASSERT_EQ(110002u, doc.count());
+    ASSERT_GE(doc.memory(), doc.count() * sizeof(json::FrozenValue) + key_bytes);
+    ASSERT_LT(doc.memory(), doc.count() * sizeof(json::FrozenValue) + key_bytes + 256);
+
+    ASSERT_EQ(9999, doc->at(json::Pointer("/items/owner=9999"))["weight"].to_int());
+    ASSERT_THROW(doc->find(json::Pointer("/items/owner=10000")), json::parse_error); // as Value does
+    ASSERT_EQ(0u, json::FrozenDocument().memory());
+
+    // the members are found when the siblings have different schemas
+    json::FrozenDocument mixed = json::freeze(json::parse(
+        "[{\"a\":1,\"id\":1},{\"id\":2},{\"b\":1,\"c\":1,\"id\":3},{\"a\":1,\"id\":4},{\"c\":5}]"));
+    for (int64_t id = 1; id <= 4; ++id) {
+        ASSERT_EQ(id, mixed->at(json::Pointer("/id=" + std::to_string(id)))["id"].to_int());
+    }
+    ASSERT_THROW(mixed->find(json::Pointer("/id=5")), json::parse_error);
+}
+
+TEST(JSON_Frozen, SharedDocument) {
+    json::SharedDocument shared;
+    ASSERT_TRUE(shared.snapshot()->is_null());
+
+    shared.publish(json::parse(spec));
+    json::FrozenDocument first = shared.snapshot();
+    ASSERT_EQ("routes", (*first)["name"].to_string());
+
+    json::FrozenDocument next = json::freeze(json::parse("{\"name\":\"next\"}"));
+    shared.publish(next);
+    ASSERT_EQ("next", (*shared.snapshot())["name"].to_string());
+    ASSERT_EQ(&next.root(), &shared.snapshot().root()); // published as is
+
+    // snapshots taken before keep their version
+    ASSERT_EQ("routes", (*first)["name"].to_string());
+}
+
+TEST(JSON_Frozen, SharedDocumentConcurrentPublish) {
+    // every version is consistent: all the routes have the version number
+    struct make {
+        static Json version(int v) {
+            Json value;
+            value["version"] = v;
+            for (int i = 0; i < 50; ++i) {
+                value["routes"].push_back(Json())["version"] = v;
+            }
+            return value;
+        }
+    };
+
+    json::SharedDocument shared(make::version(0));
+
+    std::atomic<bool> done(false);
+    std::atomic<int> bad(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.push_back(std::thread([&shared, &done, &bad]() {
+            int64_t last = 0;
+            while (!done) {
+                json::FrozenDocument doc = shared.snapshot();
+                int64_t v = (*doc)["version"].to_int();
+                const json::FrozenValue& routes = (*doc)["routes"];
+                for (const json::FrozenValue *it = routes.begin(); it != routes.end(); ++it) {
+                    if ((*it)["version"].to_int() != v) {
+                        ++bad;
+                    }
+                }
+                if (v < last) { // versions are seen in order
+                    ++bad;
+                }
+                last = v;
+            }
+        }));
+    }
+
+    for (int v = 1; v <= 200; ++v) {
+        shared.publish(make::version(v));
+    }
+    done = true;
+    for (size_t t = 0; t < readers.size(); ++t) {
+        readers[t].join();
+    }
+
+    ASSERT_EQ(0, bad.load());
+    ASSERT_EQ(200, (*shared.snapshot())["version"].to_int());
+}
+
+TEST(JSON_Frozen, SharedDocumentWritersRace) {
+    // back to back publications by several writers, each one releasing the previous version
+    json::SharedDocument shared(json::parse("{\"version\":0,\"check\":0}"));
+
+    std::atomic<bool> done(false);
+    std::atomic<int> bad(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.push_back(std::thread([&shared, &done, &bad]() {
+            while (!done) {
+                json::FrozenDocument doc = shared.snapshot();
+                if ((*doc)["version"].to_int() != -(*doc)["check"].to_int()) {
+                    ++bad;
+                }
+            }
+        }));
+    }
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 3; ++w) {
+        writers.push_back(std::thread([&shared, w]() {
+            for (int v = 1; v <= 2000; ++v) {
+                Json value;
+                value["version"] = v * 3 + w;
+                value["check"] = -(v * 3 + w);
+                shared.publish(value);
+            }
+        }));
+    }
+    for (size_t w = 0; w < writers.size(); ++w) {
+        writers[w].join();
+    }
+    done = true;
+    for (size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+
+    ASSERT_EQ(0, bad.load());
+}
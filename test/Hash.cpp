@@ -0,0 +1,90 @@
+/*!
+ * \file Hash.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include <gtest/gtest.h>
+
+#include <json.hpp>
+
+#include <unordered_set>
+
+TEST(JSON_Hash, ConsistentWithEquality) {
+    Json a = json::parse("{\"a\":[1,2,{\"b\":null}],\"c\":{\"d\":\"e\"},\"f\":1.5}");
+    Json b = json::parse("{\"f\":1.5,\"c\":{\"d\":\"e\"},\"a\":[1,2,{\"b\":null}]}");
+
+    Json c;
+    c["f"] = 1.5;
+    c["c"]["d"] = "e";
+    c["a"].push_back(1);
+    c["a"].push_back(2);
+    c["a"].push_back(Json())["b"] = Json::Null;
+
+    ASSERT_EQ(a, c);
+    ASSERT_EQ(json::hash(a), json::hash(b));
+    ASSERT_EQ(json::hash(a), json::hash(c));
+    ASSERT_EQ(json::hash(a), json::hash(json::parse_lazy(a.stringify())));
+
+    ASSERT_EQ(json::hash(Json(1)), json::hash(Json(1.0)));
+    ASSERT_EQ(json::hash(Json(0.0)), json::hash(Json(-0.0)));
+}
+
+TEST(JSON_Hash, Distinguishes) {
+    const char *specs[] = {
+        "null", "true", "false", "0", "1", "1.5", "\"\"", "\"1\"", "\"null\"", "[]", "{}",
+        "[1,2]", "[2,1]", "[[1],2]", "[1,[2]]", "{\"a\":1}", "{\"a\":\"1\"}", "{\"b\":1}",
+        "{\"a\":{}}", "{\"a\":[]}", "[{}]", "[[]]", "\"abcdefgh\"", "\"abcdefghi\"", "\"abcdefgi\""
+    };
+    size_t count = sizeof(specs) / sizeof(specs[0]);
+
+    std::unordered_set<uint64_t> hashes;
+    for (size_t i = 0; i < count; ++i) {
+        hashes.insert(json::hash(json::parse(std::string("[") + specs[i] + "]")[0]));
+    }
+    ASSERT_EQ(count, hashes.size());
+}
+
+TEST(JSON_Hash, Memoized) {
+    Json doc = json::parse("{\"users\":[{\"name\":\"a\"},{\"name\":\"b\"}],\"other\":{\"x\":[1,2,3]}}");
+    uint64_t plain = json::hash(doc);
+
+    ASSERT_EQ(plain, json::hash(doc, json::option_memoize));
+    ASSERT_EQ(plain, json::hash(doc, json::option_memoize));
+
+    doc["users"][1]["name"] = "c";
+    uint64_t changed = json::hash(doc, json::option_memoize);
+    ASSERT_NE(plain, changed);
+    ASSERT_EQ(json::hash(doc), changed);
+
+    doc.at_or_create(json::Pointer("/other/x/-")) = 4;
+    ASSERT_EQ(json::hash(doc), json::hash(doc, json::option_memoize));
+
+    doc.erase("other");
+    ASSERT_EQ(json::hash(doc), json::hash(doc, json::option_memoize));
+
+    Json copy = doc;
+    ASSERT_EQ(json::hash(doc, json::option_memoize), json::hash(copy, json::option_memoize));
+    copy["users"].push_back(Json());
+    ASSERT_NE(json::hash(doc, json::option_memoize), json::hash(copy, json::option_memoize));
+
+    doc.parse("[1,2]");
+    ASSERT_EQ(json::hash(json::parse("[1,2]")), json::hash(doc, json::option_memoize));
+}
+
+TEST(JSON_Hash, UnorderedContainers) {
+    std::unordered_set<Json> seen;
+    seen.insert(json::parse("{\"id\":1,\"tags\":[\"x\"]}"));
+    seen.insert(json::parse("{\"tags\":[\"x\"],\"id\":1}"));
+    seen.insert(json::parse("{\"id\":2,\"tags\":[\"x\"]}"));
+
+    ASSERT_EQ(2u, seen.size());
+    ASSERT_EQ(1u, seen.count(json::parse("{\"id\":2,\"tags\":[\"x\"]}")));
+}
+
+TEST(JSON_Hash, Placeholder) {
+    Json doc;
+    doc["missing"];
+    ASSERT_THROW(json::hash(doc), json::key_not_found);
+}
@@ -251,6 +251,37 @@ TEST(JSON_Parser, Parse_Char_Pointer_Sample1) {
     ASSERT_EQ("XML", value["glossary"]["GlossDiv"]["GlossList"]["GlossEntry"]["GlossDef"]["GlossSeeAlso"][1].to_string());
 }
 
+TEST(JSON_Parser, Parse_File_Sample1) {
+    Json value = json::parse_file("test/samples/1.glossary.json");
+
+    ASSERT_TRUE(value.is_object());
+    ASSERT_EQ(1, value.size());
+    ASSERT_EQ(2, value["glossary"].size());
+    ASSERT_EQ("GML", value["glossary"]["GlossDiv"]["GlossList"]["GlossEntry"]["GlossDef"]["GlossSeeAlso"][0].to_string());
+    ASSERT_EQ("XML", value["glossary"]["GlossDiv"]["GlossList"]["GlossEntry"]["GlossDef"]["GlossSeeAlso"][1].to_string());
+}
+
+TEST(JSON_Parser, Parse_File_Bad) {
+    ASSERT_THROW(json::parse_file("test/samples/does.not.exist.json"), json::parse_error);
+    ASSERT_THROW(json::parse_file("/dev/null"), json::parse_error);
+
+    try {
+        json::parse_file("test/samples/1.glossary.bad.json");
+        FAIL() << "Expected parse error";
+    } catch (const json::parse_error& e) {
+        ASSERT_EQ(11, e.line());
+        ASSERT_EQ(25, e.column());
+    }
+
+    try {
+        json::parse_file("test/samples/2.web_app.bad.json");
+        FAIL() << "Expected parse error";
+    } catch (const json::parse_error& e) {
+        ASSERT_EQ(63, e.line());
+        ASSERT_EQ(23, e.column());
+    }
+}
+
 TEST(JSON_Parser, Sample1_Bad) {
     {
         std::ifstream stream("test/samples/1.glossary.bad.json");
@@ -295,3 +326,122 @@ TEST(JSON_Parser, Sample2_Bad) {
         }
     }
 }
+
+TEST(JSON_Parser, Reusable_Parser) {
+    json::Parser parser;
+
+    for (int i = 0; i < 100; ++i) {
+        std::string str_input = "{\"data\":[{\"age\":10},\"x\"],\"id\":" + json::detail::to_string(i) + "}";
+        Json value = parser.parse(str_input);
+        ASSERT_EQ(i, value["id"].to_int());
+        ASSERT_EQ(str_input, value.stringify());
+    }
+
+    std::ifstream stream("test/samples/1.glossary.json");
+    Json value = parser.parse(stream);
+    ASSERT_EQ("XML", value["glossary"]["GlossDiv"]["GlossList"]["GlossEntry"]["GlossDef"]["GlossSeeAlso"][1].to_string());
+
+    value = parser.parse("[10,20,30,40]", 13);
+    ASSERT_TRUE(value.is_array());
+    ASSERT_EQ(4, value.size());
+}
+
+TEST(JSON_Parser, Reusable_Parser_After_Error) {
+    json::Parser parser;
+
+    const char *errors[] = { "{\"data\":[{\"age\":10}", "{\"a\":\"b", "{\"a\"::1}", "[1,2,]" };
+    for (size_t e = 0; e < sizeof(errors) / sizeof(errors[0]); ++e) {
+        ASSERT_THROW(parser.parse(errors[e]), json::parse_error);
+
+        Json value = parser.parse(std::string("{\"a\":[1,{\"b\":\"c\"}]}"));
+        ASSERT_EQ("{\"a\":[1,{\"b\":\"c\"}]}", value.stringify());
+    }
+
+    std::ifstream stream("test/samples/2.web_app.bad.json");
+    try {
+        parser.parse(stream);
+        FAIL() << "Expected parse error";
+    } catch (const json::parse_error& e) {
+        ASSERT_EQ(63, e.line());
+        ASSERT_EQ(23, e.column());
+    }
+}
+
+static std::string make_records(size_t count) {
+    std::ostringstream oss;
+    oss << "[\n";
+    for (size_t i = 0; i < count; ++i) {
+        oss << (i ? ",\n" : "")
+            << "  {\"id\":" << i << ",\"name\":\"item, [" << i << "] \\\"quoted\\\"\""
+            << ",\"tags\":[\"a\",{\"b\":[1,2,{}]}],\"active\":" << (i % 2 ? "true" : "false") << "}";
+        if (i % 7 == 0) {
+            oss << ",\n  " << i << ",\"}]{[,\",null,[]";
+        }
+    }
+    oss << "\n]\n";
+    return oss.str();
+}
+
+TEST(JSON_Parser, Parallel_Array) {
+    std::string str_input = make_records(2000);
+    Json expected = json::parse(str_input);
+
+    for (unsigned int threads = 1; threads <= 8; ++threads) {
+        Json value = json::parse_parallel(str_input, threads);
+        ASSERT_TRUE(value.is_array());
+        ASSERT_EQ(expected.size(), value.size());
+        ASSERT_EQ(expected.stringify(), value.stringify());
+    }
+}
+
+TEST(JSON_Parser, Parallel_Not_An_Array) {
+    std::string str_input = "{\"data\":" + make_records(1000) + "}";
+    Json value = json::parse_parallel(str_input, 4);
+    ASSERT_TRUE(value.is_object());
+    ASSERT_EQ(json::parse(str_input).stringify(), value.stringify());
+
+    str_input = make_records(1000);
+    str_input.insert(str_input.find(",\n  {\"id\":500") + 1, "/* comment, ] */");
+    value = json::parse_parallel(str_input, 4);
+    ASSERT_TRUE(value.is_array());
+    ASSERT_EQ(json::parse(str_input).stringify(), value.stringify());
+}
+
+TEST(JSON_Parser, Parallel_Array_Error) {
+    const char *errors[] = { "x", ",", "]", "[", "\"", "}" };
+    for (size_t e = 0; e < sizeof(errors) / sizeof(errors[0]); ++e) {
+        std::string str_input = make_records(2000);
+        str_input.insert(str_input.find("\"id\":1500"), errors[e]);
+
+        unsigned int line = 0, column = 0;
+        try {
+            json::parse(str_input);
+            FAIL() << "Expected parse error for " << errors[e];
+        } catch (const json::parse_error& err) {
+            line = err.line();
+            column = err.column();
+        }
+
+        try {
+            json::parse_parallel(str_input, 4);
+            FAIL() << "Expected parse error for " << errors[e];
+        } catch (const json::parse_error& err) {
+            ASSERT_EQ(line, err.line());
+            ASSERT_EQ(column, err.column());
+        }
+    }
+}
+
+TEST(JSON_Parser, Parallel_Array_Bad_Closer) {
+    std::ostringstream oss;
+    oss << "[";
+    for (int i = 0; i < 5000; ++i) {
+        oss << (i ? "," : "") << i;
+    }
+    oss << "}";
+    std::string str_input = oss.str();
+    ASSERT_GT(str_input.size(), 8192u);
+
+    ASSERT_THROW(json::parse(str_input), json::parse_error);
+    ASSERT_THROW(json::parse_parallel(str_input, 4), json::parse_error);
+}
@@ -0,0 +1,126 @@
+/*!
+ * \file Lazy.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include <fstream>
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include <json.hpp>
+
+static std::string read_file(const char *path) {
+    std::ifstream stream(path);
+    std::ostringstream oss;
+    oss << stream.rdbuf();
+    return oss.str();
+}
+
+TEST(JSON_Lazy, Same_As_Parse) {
+    const char *samples[] = { "test/samples/1.glossary.json", "test/samples/2.web_app.json" };
+    for (size_t i = 0; i < sizeof(samples)/sizeof(samples[0]); ++i) {
+        std::string spec = read_file(samples[i]);
+        ASSERT_EQ(json::parse(spec).stringify(true), json::parse_lazy(spec).stringify(true));
+    }
+}
+
+TEST(JSON_Lazy, Verbatim_When_Untouched) {
+    std::string spec = "{ \"b\" : [ 1,  2.50 ,\"x\\u0041\" ], \"a\": { \"z\" : null }  }";
+    Json value = json::parse_lazy("  " + spec + "\n");
+    ASSERT_EQ(spec, value.stringify());
+
+    // only the top-level object gets decoded
+    ASSERT_EQ(2, value.size());
+    ASSERT_EQ("{\"a\":{ \"z\" : null },\"b\":[ 1,  2.50 ,\"x\\u0041\" ]}", value.stringify());
+
+    value["a"]["y"] = true;
+    ASSERT_EQ("{\"a\":{\"y\":true,\"z\":null},\"b\":[ 1,  2.50 ,\"x\\u0041\" ]}", value.stringify());
+}
+
+TEST(JSON_Lazy, Values) {
+    Json value = json::parse_lazy("[\"x\\u0041\\n\\ud83d\\ude00\", -12, 1.5e3, true, false, null, {}, []]");
+
+    ASSERT_EQ(8, value.size());
+    ASSERT_EQ("xA\n\xF0\x9F\x98\x80", value[0].to_string());
+    ASSERT_TRUE(value[1].is_integer());
+    ASSERT_EQ(-12, value[1].to_int());
+    ASSERT_TRUE(value[2].is_double());
+    ASSERT_EQ(1500.0, value[2].to_double());
+    ASSERT_TRUE(value[3].to_bool());
+    ASSERT_FALSE(value[4].to_bool());
+    ASSERT_TRUE(value[5].is_null());
+    ASSERT_TRUE(value[6].is_object());
+    ASSERT_TRUE(value[6].empty());
+    ASSERT_TRUE(value[7].is_array());
+    ASSERT_TRUE(value[7].empty());
+}
+
+TEST(JSON_Lazy, Pointer) {
+    Json value = json::parse_lazy(read_file("test/samples/2.web_app.json"));
+
+    ASSERT_EQ("org.cofax.cds.FileServlet",
+              value[json::Pointer("/web-app/servlet/servlet-name=fileServlet")]["servlet-class"].to_string());
+    ASSERT_TRUE(value.exists(json::Pointer("/web-app/servlet-mapping/cofaxTools")));
+    ASSERT_FALSE(value.exists(json::Pointer("/web-app/servlet-mapping/nope")));
+
+    const Json& cvalue = value;
+    ASSERT_NE(cvalue.find("web-app"), cvalue.end());
+    ASSERT_EQ("/tools/*", cvalue["web-app"]["servlet-mapping"]["cofaxTools"].to_string());
+}
+
+TEST(JSON_Lazy, Copies_Are_Independent) {
+    Json value = json::parse_lazy("{\"a\":[1,2,3],\"b\":{\"c\":\"d\"}}");
+    Json copy = value;
+
+    copy["a"].push_back(4);
+    ASSERT_EQ(3, value["a"].size());
+    ASSERT_EQ(4, copy["a"].size());
+    ASSERT_EQ("{\"c\":\"d\"}", value["b"].stringify());
+    ASSERT_EQ("{\"c\":\"d\"}", copy["b"].stringify());
+}
+
+TEST(JSON_Lazy, Errors) {
+    ASSERT_THROW(json::parse_lazy("[1, 2"), json::parse_error);
+    ASSERT_THROW(json::parse_lazy("[1] x"), json::parse_error);
+    ASSERT_THROW(json::parse_lazy("[1 /* comment */]"), json::parse_error);
+    ASSERT_THROW(json::parse_lazy(""), json::parse_error);
+
+    try {
+        json::parse_lazy(read_file("test/samples/1.glossary.bad.json"));
+        FAIL() << "Expected parse error";
+    } catch (const json::parse_error& e) {
+        ASSERT_EQ(11, e.line());
+        ASSERT_EQ(25, e.column());
+    }
+}
+
+TEST(JSON_Lazy, Raw_Subtrees) {
+    std::vector<json::Pointer> raw;
+    raw.push_back(json::Pointer("/payload"));
+    raw.push_back(json::Pointer("/missing/key"));
+
+    Json value = json::parse("{\"id\": 7, \"meta\": { \"a\" : [ 1 ] }, \"payload\": { \"big\" : [1, 2,3] }}", raw);
+    ASSERT_FALSE(value.is_raw());
+    ASSERT_FALSE(value["meta"].is_raw());
+    ASSERT_FALSE(value["meta"]["a"].is_raw());
+    ASSERT_TRUE(value["payload"].is_raw());
+    ASSERT_EQ(7, value["id"].to_int());
+    ASSERT_EQ("{\"id\":7,\"meta\":{\"a\":[1]},\"payload\":{ \"big\" : [1, 2,3] }}", value.stringify());
+
+    // decoded when accessed
+    ASSERT_EQ(3, value["payload"]["big"].size());
+    ASSERT_FALSE(value["payload"].is_raw());
+    ASSERT_EQ("{\"big\":[1,2,3]}", value["payload"].stringify());
+}
+
+TEST(JSON_Lazy, Raw_Array_Elements) {
+    std::vector<json::Pointer> raw;
+    raw.push_back(json::Pointer("/1"));
+
+    Json value = json::parse("[ [ 0 ], [ 1 ], \"two\" ]", raw);
+    ASSERT_FALSE(value[0].is_raw());
+    ASSERT_TRUE(value[1].is_raw());
+    ASSERT_EQ("[[0],[ 1 ],\"two\"]", value.stringify());
+}
@@ -315,3 +315,188 @@ TEST(JSON_Object, GetOptional) {
     ASSERT_THROW(obj.get_optional<float>("astring"), json::bad_json_type);
     ASSERT_THROW(obj.get_optional<double>("astring"), json::bad_json_type);
 }
+
+TEST(JSON_Object, MergePatch) {
+    // RFC-7386, appendix A
+    const char *cases[][3] = {
+        { "{\"a\":\"b\"}", "{\"a\":\"c\"}", "{\"a\":\"c\"}" },
+        { "{\"a\":\"b\"}", "{\"b\":\"c\"}", "{\"a\":\"b\",\"b\":\"c\"}" },
+        { "{\"a\":\"b\"}", "{\"a\":null}", "{}" },
+        { "{\"a\":\"b\",\"b\":\"c\"}", "{\"a\":null}", "{\"b\":\"c\"}" },
+        { "{\"a\":[\"b\"]}", "{\"a\":\"c\"}", "{\"a\":\"c\"}" },
+        { "{\"a\":\"c\"}", "{\"a\":[\"b\"]}", "{\"a\":[\"b\"]}" },
+        { "{\"a\":{\"b\":\"c\"}}", "{\"a\":{\"b\":\"d\",\"c\":null}}", "{\"a\":{\"b\":\"d\"}}" },
+        { "{\"a\":[{\"b\":\"c\"}]}", "{\"a\":[1]}", "{\"a\":[1]}" },
+        { "[\"a\",\"b\"]", "[\"c\",\"d\"]", "[\"c\",\"d\"]" },
+        { "{\"a\":\"b\"}", "[\"c\"]", "[\"c\"]" },
+        { "{\"e\":null}", "{\"a\":1}", "{\"a\":1,\"e\":null}" },
+        { "[1,2]", "{\"a\":\"b\",\"c\":null}", "{\"a\":\"b\"}" },
+        { "{}", "{\"a\":{\"bb\":{\"ccc\":null}}}", "{\"a\":{\"bb\":{}}}" },
+    };
+
+    for (size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); ++i) {
+        Json target = json::parse(cases[i][0]);
+        ASSERT_EQ(cases[i][2], target.merge_patch(json::parse(cases[i][1])).stringify()) << i;
+
+        Json copy = json::parse(cases[i][0]);
+        const Json patch = json::parse(cases[i][1]);
+        ASSERT_EQ(cases[i][2], copy.merge_patch(patch).stringify()) << i;
+    }
+
+    Json obj;
+    obj["new"].merge_patch(json::parse("{\"a\":1}"));
+    ASSERT_EQ("{\"new\":{\"a\":1}}", obj.stringify());
+}
+
+TEST(JSON_Object, DeepEquality) {
+    Json a = json::parse("{\"a\":[1,2,{\"b\":null}],\"c\":{\"d\":\"e\"},\"f\":1.5}");
+    Json b = json::parse("{\"f\":1.5,\"c\":{\"d\":\"e\"},\"a\":[1,2,{\"b\":null}]}");
+    Json c = json::parse("{\"a\":[1,2,{\"b\":false}],\"c\":{\"d\":\"e\"},\"f\":1.5}");
+
+    ASSERT_TRUE(a == b);
+    ASSERT_FALSE(a != b);
+    ASSERT_TRUE(a != c);
+    ASSERT_TRUE(Json() == Json());
+    ASSERT_FALSE(json::parse("[1]") == json::parse("[1.0]"));
+    ASSERT_FALSE(json::parse("[1]") == json::parse("[1,2]"));
+
+    ASSERT_TRUE(json::parse("[1]").equals(json::parse("[1.0]"), 0));
+    ASSERT_TRUE(json::parse("{\"x\":[0.1]}").equals(json::parse("{\"x\":[0.1000001]}"), 1e-6));
+    ASSERT_FALSE(json::parse("{\"x\":[0.1]}").equals(json::parse("{\"x\":[0.1001]}"), 1e-6));
+    ASSERT_FALSE(json::parse("[1]").equals(json::parse("[\"1\"]"), 1));
+}
+
+TEST(JSON_Object, Ordering) {
+    std::vector<Json> values;
+    values.push_back(json::parse("{\"b\":1}"));
+    values.push_back(json::parse("[2]"));
+    values.push_back(json::parse("{\"a\":2}"));
+    values.push_back(json::parse("[1,2]"));
+    values.push_back(Json("x"));
+    values.push_back(json::parse("[1]"));
+    values.push_back(Json(3));
+    values.push_back(json::parse("{\"a\":1}"));
+    values.push_back(Json::Null);
+    values.push_back(Json(true));
+
+    std::map<Json, size_t> sorted;
+    for (size_t i = 0; i < values.size(); ++i) {
+        sorted[values[i]] = i;
+    }
+    sorted[json::parse("[1,2]")] = 99; // same key
+
+    std::string order;
+    for (std::map<Json, size_t>::const_iterator it = sorted.begin(); it != sorted.end(); ++it) {
+        order += it->first.stringify() + " ";
+    }
+    ASSERT_EQ("null true 3 \"x\" [1] [1,2] [2] {\"a\":1} {\"a\":2} {\"b\":1} ", order);
+    ASSERT_EQ(99, sorted[json::parse("[1,2]")]);
+
+    ASSERT_EQ(0, json::parse("{\"a\":[1]}").compare(json::parse("{\"a\":[1]}")));
+    ASSERT_TRUE(json::parse("[1]") < json::parse("[1,0]"));
+    ASSERT_TRUE(json::parse("[2]") >= json::parse("[1,0]"));
+}
+
+TEST(JSON_Object, SharedCopies) {
+    const Json config = json::parse("{\"db\":{\"host\":\"localhost\",\"port\":5432},\"cache\":{\"ttl\":60},\"hosts\":[\"a\",\"b\"]}");
+
+    Json context = config;
+    const Json& shared = context;
+    ASSERT_EQ(&config.to_map(), &shared.to_map());
+    ASSERT_EQ(&config["db"].to_map(), &shared["db"].to_map());
+
+    // only the path to the modified value is copied
+    context["db"]["port"] = 6543;
+    ASSERT_EQ(5432, config["db"]["port"].to_int());
+    ASSERT_EQ(6543, shared["db"]["port"].to_int());
+    ASSERT_NE(&config["db"].to_map(), &shared["db"].to_map());
+    ASSERT_EQ(&config["cache"].to_map(), &shared["cache"].to_map());
+    ASSERT_EQ(&config["hosts"].to_array(), &shared["hosts"].to_array());
+
+    context["hosts"].push_back("c");
+    context.erase("cache");
+    context.set(json::Pointer("/db/user"), "admin");
+    context.erase(json::Pointer("/hosts/0"));
+    ASSERT_EQ("{\"db\":{\"host\":\"localhost\",\"port\":6543,\"user\":\"admin\"},\"hosts\":[\"b\",\"c\"]}", context.stringify());
+    ASSERT_EQ("{\"cache\":{\"ttl\":60},\"db\":{\"host\":\"localhost\",\"port\":5432},\"hosts\":[\"a\",\"b\"]}", config.stringify());
+}
+
+TEST(JSON_Object, SharedCopiesAndReferences) {
+    Json doc = json::parse("{\"a\":{\"b\":[1,2]},\"c\":{\"d\":true}}");
+
+    // references handed out before copying are not shared with the copy
+    Json& b = doc["a"]["b"];
+    Json copy = doc;
+    b.push_back(3);
+    b[0] = 0;
+    ASSERT_EQ("[0,2,3]", doc["a"]["b"].stringify());
+    ASSERT_EQ("[1,2]", copy["a"]["b"].stringify());
+
+    Json other = doc;
+    for (Json::iterator it = doc.begin(); it != doc.end(); ++it) {
+        it->second = Json::Null;
+    }
+    ASSERT_EQ("{\"a\":null,\"c\":null}", doc.stringify());
+    ASSERT_EQ("{\"a\":{\"b\":[0,2,3]},\"c\":{\"d\":true}}", other.stringify());
+
+    Json last = other;
+    Json *d = last.find(json::Pointer("/c/d"));
+    ASSERT_NE(nullptr, d);
+    *d = false;
+    ASSERT_TRUE(other["c"]["d"].to_bool());
+    ASSERT_FALSE(last["c"]["d"].to_bool());
+
+    // self assignment from a child
+    last = last["a"];
+    ASSERT_EQ("{\"b\":[0,2,3]}", last.stringify());
+}
+
+TEST(JSON_Object, SharedCopiesAndConstReferences) {
+    Json doc = json::parse("{\"x\":{\"y\":1}}");
+    const Json& cdoc = doc;
+
+    // modifying the value invalidates const references, they are taken again
+    const Json *x = &cdoc["x"];
+    {
+        Json copy = doc;
+        doc["x"]["y"] = 5;
+        const Json& ccopy = copy;
+        ASSERT_EQ(&ccopy["x"], x); // left to the copy
+        ASSERT_EQ(1, (*x)["y"].to_int());
+        x = &cdoc["x"];
+    }
+    ASSERT_EQ(5, (*x)["y"].to_int());
+
+    // those obtained from a value that is not modified stay valid
+    const Json original = doc;
+    const Json& y = original["x"]["y"];
+    doc["x"]["y"] = 6;
+    ASSERT_EQ(5, y.to_int());
+    ASSERT_EQ(6, cdoc["x"]["y"].to_int());
+}
+
+TEST(JSON_Object, Placeholders) {
+    Json obj;
+    Json& placeholder = obj["a long key, not short enough to be stored inline"];
+
+    try {
+        placeholder.to_string();
+        FAIL();
+    } catch (const json::key_not_found& e) {
+        ASSERT_NE(std::string::npos, std::string(e.what()).find("a long key, not short enough"));
+    }
+
+    // the key is not taken for the content
+    placeholder["b"] = "x";
+    ASSERT_EQ("{\"a long key, not short enough to be stored inline\":{\"b\":\"x\"}}", obj.stringify());
+
+    obj["c"].push_back("d");
+    json::Pointer("/e/f").get_or_create(obj) = 1;
+    ASSERT_EQ(json::parse("{\"a long key, not short enough to be stored inline\":{\"b\":\"x\"},\"c\":[\"d\"],\"e\":{\"f\":1}}"), obj);
+
+    // strings are decoded in place, whatever their length
+    Json parsed = json::parse("[\"\",\"short\",\"a string longer than the inline storage of std::string\"]");
+    ASSERT_EQ("", parsed[0].to_string());
+    ASSERT_EQ("short", parsed[1].to_string());
+    ASSERT_EQ("a string longer than the inline storage of std::string", parsed[2].to_string());
+}
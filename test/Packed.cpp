@@ -0,0 +1,220 @@
+/*!
+ * \file Packed.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include <gtest/gtest.h>
+
+#include <json.hpp>
+
+#include <thread>
+
+/* the integers in [0, count), or doubles having the given decimals */
+static std::string numbers(int count, const char *decimals = "") {
+    std::string spec = "[";
+    for (int i = 0; i < count; ++i) {
+        spec += (i ? "," : "") + std::to_string(i) + decimals;
+    }
+    return spec + "]";
+}
+
+/* `count` objects having the same keys */
+static std::string records(int count) {
+    std::string spec = "[";
+    for (int i = 0; i < count; ++i) {
+        std::string n = std::to_string(i);
+        spec += (i ? "," : "");
+        spec += "{\"ts\":" + n + ",\"v\":" + n + ".5,\"name\":\"r" + n + "\",\"tags\":[" + n + "],\"ok\":true}";
+    }
+    return spec + "]";
+}
+
+TEST(JSON_Packed, Columns) {
+    Json doc = json::parse("{\"records\":" + records(100) + ",\"few\":" + records(3) + "}", json::option_pack);
+
+    const Json& rows = doc["records"];
+    ASSERT_TRUE(rows.is_packed());
+    ASSERT_FALSE(rows.is_raw());
+    ASSERT_FALSE(doc["few"].is_packed());
+    ASSERT_EQ(100u, rows.size());
+    ASSERT_FALSE(rows.empty());
+
+    json::span<const int64_t> ts = rows.to_int_column("ts");
+    ASSERT_EQ(100u, ts.size());
+    int64_t sum = 0;
+    for (const int64_t *it = ts.begin(); it != ts.end(); ++it) {
+        sum += *it;
+    }
+    ASSERT_EQ(4950, sum);
+    ASSERT_EQ(99.5, rows.to_double_column("v")[99]);
+
+    ASSERT_THROW(rows.to_double_column("ts"), json::bad_json_type);
+    ASSERT_THROW(rows.to_int_column("name"), json::bad_json_type);
+    ASSERT_THROW(rows.to_int_column("tags"), json::bad_json_type);
+    ASSERT_THROW(rows.to_int_column("missing"), json::key_not_found);
+    ASSERT_THROW(doc["few"].to_int_column("ts"), json::bad_json_type);
+    ASSERT_THROW(rows.to_map(), json::bad_json_type);
+
+    // written as if the elements were created
+    Json plain = json::parse(records(100));
+    ASSERT_FALSE(plain.is_packed()); // only on request
+    ASSERT_EQ(plain.stringify(), rows.stringify());
+    ASSERT_EQ(plain.stringify(true), rows.stringify(true));
+}
+
+TEST(JSON_Packed, OnlyOnRequest) {
+    // arrays parsed by default are not packed, so they can be read by many threads
+    const Json doc = json::parse(records(64));
+    ASSERT_FALSE(doc.is_packed());
+
+    std::vector<std::thread> readers;
+    std::vector<int64_t> sums(4, 0);
+    for (size_t t = 0; t < sums.size(); ++t) {
+        readers.push_back(std::thread([&doc, &sums, t]() {
+            for (size_t i = 0; i < doc.size(); ++i) {
+                sums[t] += doc[i]["ts"].to_int();
+            }
+        }));
+    }
+    for (size_t t = 0; t < readers.size(); ++t) {
+        readers[t].join();
+        ASSERT_EQ(2016, sums[t]);
+    }
+}
+
+TEST(JSON_Packed, Transparent) {
+    Json doc = json::parse("{\"records\":" + records(20) + "}", json::option_pack);
+    Json copy = doc;
+
+    Json expected = Json::array_type();
+    for (int i = 0; i < 20; ++i) {
+        Json& row = expected.push_back(Json());
+        row["ts"] = i;
+        row["v"] = i + 0.5;
+        row["name"] = "r" + std::to_string(i);
+        row["tags"].push_back(i);
+        row["ok"] = true;
+    }
+    ASSERT_EQ(expected.stringify(), doc["records"].stringify());
+    ASSERT_EQ(json::hash(expected), json::hash(doc["records"]));
+    ASSERT_EQ(json::hash(doc["records"], json::option_memoize), json::hash(doc["records"]));
+
+    // elements are created on demand, copies are not affected
+    ASSERT_EQ("r7", doc["records"][7]["name"].to_string());
+    ASSERT_FALSE(doc["records"].is_packed());
+    ASSERT_TRUE(copy["records"].is_packed());
+    ASSERT_EQ(expected, doc["records"]);
+    ASSERT_EQ(doc, copy);
+
+    // heterogeneous insert
+    copy["records"].push_back("twenty");
+    ASSERT_FALSE(copy["records"].is_packed());
+    ASSERT_EQ(21u, copy["records"].size());
+    ASSERT_FALSE(copy["records"].pack());
+
+    ASSERT_EQ(3, doc.at(json::Pointer("/records/ts=3/tags/0")).to_int());
+    ASSERT_EQ(19, json::freeze(json::parse(records(20), json::option_pack))->at(19)["ts"].to_int());
+}
+
+TEST(JSON_Packed, Pack) {
+    Json array;
+    ASSERT_FALSE(array.pack()); // an object
+
+    array.push_back(Json())["a"] = 1;
+    array.push_back(Json())["a"] = "x";
+    ASSERT_TRUE(array.pack());
+    ASSERT_TRUE(array.pack());
+    ASSERT_THROW(array.to_int_column("a"), json::bad_json_type);
+    ASSERT_EQ("[{\"a\":1},{\"a\":\"x\"}]", array.stringify());
+
+    Json empty = Json::array_type();
+    ASSERT_FALSE(empty.pack());
+    ASSERT_TRUE(empty.empty());
+
+    ASSERT_FALSE(json::parse("[{\"a\":1},{\"b\":1}]").pack());
+    ASSERT_FALSE(json::parse("[{\"a\":1},{\"a\":1,\"b\":1}]").pack());
+    ASSERT_FALSE(json::parse("[{},{}]").pack());
+}
+
+TEST(JSON_Packed, Parallel) {
+    std::string spec = records(2000);
+    Json doc = json::parse_parallel(spec.data(), spec.size(), 4);
+    ASSERT_FALSE(doc.is_packed());
+    ASSERT_TRUE(doc.pack());
+    ASSERT_EQ(2000u, doc.to_int_column("ts").size());
+    ASSERT_EQ(1999, doc.to_int_column("ts")[1999]);
+    ASSERT_EQ(json::parse(spec).stringify(), doc.stringify());
+}
+
+TEST(JSON_Packed, Numbers) {
+    Json doc = json::parse("{\"ints\":" + numbers(100) + ",\"dbls\":" + numbers(100, ".5")
+                           + ",\"small\":" + numbers(3)
+                           + ",\"ints_and_dbls\":" + numbers(20).substr(0, numbers(20).size() - 1) + ",1.5]}",
+                           json::option_pack);
+
+    ASSERT_TRUE(doc["ints"].is_packed());
+    ASSERT_TRUE(doc["dbls"].is_packed());
+    ASSERT_FALSE(doc["small"].is_packed());
+    ASSERT_FALSE(doc["ints_and_dbls"].is_packed());
+
+    const Json& ints = doc["ints"];
+    ASSERT_EQ(100u, ints.size());
+    ASSERT_FALSE(ints.empty());
+    json::span<const int64_t> values = ints.to_int_span();
+    ASSERT_EQ(100u, values.size());
+    int64_t sum = 0;
+    for (const int64_t *it = values.begin(); it != values.end(); ++it) {
+        sum += *it;
+    }
+    ASSERT_EQ(4950, sum);
+    ASSERT_EQ(99.5, doc["dbls"].to_double_span()[99]);
+
+    ASSERT_THROW(ints.to_double_span(), json::bad_json_type);
+    ASSERT_THROW(ints.to_int_column("a"), json::bad_json_type);
+    ASSERT_THROW(doc["dbls"].to_int_span(), json::bad_json_type);
+    ASSERT_THROW(doc["small"].to_int_span(), json::bad_json_type);
+    ASSERT_THROW(json::parse(records(20), json::option_pack).to_int_span(), json::bad_json_type);
+
+    // written as if the elements were created
+    ASSERT_EQ(numbers(100), doc["ints"].stringify());
+    Json plain = json::parse(numbers(100, ".5"));
+    ASSERT_EQ(plain.stringify(true), doc["dbls"].stringify(true));
+    ASSERT_EQ(json::hash(plain), json::hash(doc["dbls"]));
+    ASSERT_EQ(json::hash(json::parse(numbers(100))), json::hash(ints));
+}
+
+TEST(JSON_Packed, NumbersTransparent) {
+    Json doc = json::parse(numbers(20), json::option_pack);
+    Json copy = doc;
+
+    ASSERT_EQ(7, doc[7].to_int());
+    ASSERT_FALSE(doc.is_packed());
+    ASSERT_TRUE(copy.is_packed());
+    ASSERT_EQ(doc, copy);
+
+    // heterogeneous insert
+    copy.push_back("twenty");
+    ASSERT_FALSE(copy.is_packed());
+    ASSERT_EQ(21u, copy.size());
+    ASSERT_EQ("twenty", copy[20].to_string());
+    ASSERT_FALSE(copy.pack());
+
+    Json dbls = Json::array_type();
+    dbls.push_back(1.5);
+    dbls.push_back(-2.0);
+    ASSERT_TRUE(dbls.pack());
+    ASSERT_EQ(2u, dbls.to_double_span().size());
+    ASSERT_EQ(json::parse("[1.5,-2.0]").stringify(), dbls.stringify());
+
+    Json mixed = json::parse("[1,2.5]");
+    ASSERT_FALSE(mixed.pack());
+    ASSERT_TRUE(mixed[0].is_integer());
+
+    std::string spec = numbers(5000);
+    Json parallel = json::parse_parallel(spec.data(), spec.size(), 4);
+    ASSERT_TRUE(parallel.pack());
+    ASSERT_EQ(4999, parallel.to_int_span()[4999]);
+    ASSERT_EQ(spec, parallel.stringify());
+}
@@ -0,0 +1,213 @@
+/*!
+ * \file Patch.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include <gtest/gtest.h>
+
+#include <json.hpp>
+
+static std::string patched(const std::string& doc, const std::string& patch) {
+    Json json = json::parse(doc);
+    json::Patch(json::parse(patch)).apply(json);
+    return json.stringify();
+}
+
+TEST(JSON_Patch, Add) {
+    ASSERT_EQ("{\"baz\":\"qux\",\"foo\":\"bar\"}",
+              patched("{\"foo\":\"bar\"}", "[{\"op\":\"add\",\"path\":\"/baz\",\"value\":\"qux\"}]"));
+    ASSERT_EQ("{\"foo\":[\"bar\",\"qux\",\"baz\"]}",
+              patched("{\"foo\":[\"bar\",\"baz\"]}", "[{\"op\":\"add\",\"path\":\"/foo/1\",\"value\":\"qux\"}]"));
+    ASSERT_EQ("{\"foo\":[\"bar\",[\"abc\",\"def\"]]}",
+              patched("{\"foo\":[\"bar\"]}", "[{\"op\":\"add\",\"path\":\"/foo/-\",\"value\":[\"abc\",\"def\"]}]"));
+    ASSERT_EQ("{\"foo\":\"baz\"}",
+              patched("{\"foo\":\"bar\"}", "[{\"op\":\"add\",\"path\":\"/foo\",\"value\":\"baz\"}]"));
+    ASSERT_EQ("[1]", patched("{\"foo\":\"bar\"}", "[{\"op\":\"add\",\"path\":\"\",\"value\":[1]}]"));
+}
+
+TEST(JSON_Patch, RemoveReplace) {
+    ASSERT_EQ("{\"foo\":\"bar\"}",
+              patched("{\"baz\":\"qux\",\"foo\":\"bar\"}", "[{\"op\":\"remove\",\"path\":\"/baz\"}]"));
+    ASSERT_EQ("{\"foo\":[\"bar\",\"baz\"]}",
+              patched("{\"foo\":[\"bar\",\"qux\",\"baz\"]}", "[{\"op\":\"remove\",\"path\":\"/foo/1\"}]"));
+    ASSERT_EQ("{\"baz\":\"boo\",\"foo\":\"bar\"}",
+              patched("{\"baz\":\"qux\",\"foo\":\"bar\"}", "[{\"op\":\"replace\",\"path\":\"/baz\",\"value\":\"boo\"}]"));
+}
+
+TEST(JSON_Patch, MoveCopy) {
+    ASSERT_EQ("{\"foo\":{\"bar\":\"baz\"},\"qux\":{\"corge\":\"grault\",\"thud\":\"fred\"}}",
+              patched("{\"foo\":{\"bar\":\"baz\",\"waldo\":\"fred\"},\"qux\":{\"corge\":\"grault\"}}",
+                      "[{\"op\":\"move\",\"from\":\"/foo/waldo\",\"path\":\"/qux/thud\"}]"));
+    ASSERT_EQ("{\"foo\":[\"all\",\"cows\",\"eat\",\"grass\"]}",
+              patched("{\"foo\":[\"all\",\"grass\",\"cows\",\"eat\"]}",
+                      "[{\"op\":\"move\",\"from\":\"/foo/1\",\"path\":\"/foo/3\"}]"));
+    ASSERT_EQ("{\"a\":{\"b\":[1,2]},\"c\":{\"b\":[1,2]}}",
+              patched("{\"a\":{\"b\":[1,2]}}", "[{\"op\":\"copy\",\"from\":\"/a\",\"path\":\"/c\"}]"));
+
+    Json json = json::parse("{\"a\":{\"b\":[1,2]}}");
+    ASSERT_THROW(json::Patch(json::parse("[{\"op\":\"move\",\"from\":\"/a\",\"path\":\"/a/b/c\"}]")).apply(json),
+                 json::patch_error);
+}
+
+TEST(JSON_Patch, Test) {
+    std::string doc = "{\"baz\":\"qux\",\"foo\":[\"a\",2,\"c\"],\"n\":{\"x\":1.0}}";
+    ASSERT_EQ(json::parse(doc).stringify(),
+              patched(doc, "[{\"op\":\"test\",\"path\":\"/baz\",\"value\":\"qux\"},"
+                           " {\"op\":\"test\",\"path\":\"/foo/1\",\"value\":2},"
+                           " {\"op\":\"test\",\"path\":\"/n\",\"value\":{\"x\":1}}]"));
+    ASSERT_THROW(patched(doc, "[{\"op\":\"test\",\"path\":\"/baz\",\"value\":\"bar\"}]"), json::patch_error);
+    ASSERT_THROW(patched(doc, "[{\"op\":\"test\",\"path\":\"/foo\",\"value\":[\"a\",2]}]"), json::patch_error);
+}
+
+TEST(JSON_Patch, Rollback) {
+    std::string doc = "{\"a\":{\"b\":[1,2,3]},\"c\":\"d\",\"e\":[{\"f\":1}]}";
+    Json json = json::parse(doc);
+
+    json::Patch patch(json::parse("["
+        "{\"op\":\"add\",\"path\":\"/a/b/1\",\"value\":9},"
+        "{\"op\":\"remove\",\"path\":\"/c\"},"
+        "{\"op\":\"replace\",\"path\":\"/a/b/0\",\"value\":\"x\"},"
+        "{\"op\":\"move\",\"from\":\"/e/0\",\"path\":\"/a/b/-\"},"
+        "{\"op\":\"copy\",\"from\":\"/a\",\"path\":\"/g\"},"
+        "{\"op\":\"add\",\"path\":\"/a\",\"value\":null},"
+        "{\"op\":\"move\",\"from\":\"/g\",\"path\":\"/e\"},"
+        "{\"op\":\"test\",\"path\":\"/e/b/0\",\"value\":\"x\"},"
+        "{\"op\":\"remove\",\"path\":\"/missing\"}"
+    "]"));
+    ASSERT_EQ(9, patch.size());
+
+    ASSERT_THROW(patch.apply(json), json::patch_error);
+    ASSERT_EQ(json::parse(doc).stringify(), json.stringify());
+
+    // moves within an array
+    doc = "{\"a\":[1,2,3],\"b\":[]}";
+    json = json::parse(doc);
+    ASSERT_THROW(json::Patch(json::parse("["
+        "{\"op\":\"move\",\"from\":\"/a/0\",\"path\":\"/a/2\"},"
+        "{\"op\":\"move\",\"from\":\"/a/0\",\"path\":\"/b/0\"},"
+        "{\"op\":\"move\",\"from\":\"/a\",\"path\":\"/c\"},"
+        "{\"op\":\"test\",\"path\":\"/x\",\"value\":1}"
+    "]")).apply(json), json::patch_error);
+    ASSERT_EQ(json::parse(doc).stringify(), json.stringify());
+
+    // <key>=<value> tokens no longer matching once changed
+    doc = "{\"arr\":[{\"id\":4,\"n\":0},{\"id\":5,\"n\":1}]}";
+    json = json::parse(doc);
+    ASSERT_THROW(json::Patch(json::parse("["
+        "{\"op\":\"replace\",\"path\":\"/arr/id=5/id\",\"value\":6},"
+        "{\"op\":\"add\",\"path\":\"/arr/id=6/m\",\"value\":2},"
+        "{\"op\":\"remove\",\"path\":\"/arr/id=6/n\"},"
+        "{\"op\":\"move\",\"from\":\"/arr/id=6\",\"path\":\"/arr/id=4/o\"},"
+        "{\"op\":\"test\",\"path\":\"/x\",\"value\":1}"
+    "]")).apply(json), json::patch_error);
+    ASSERT_EQ(json::parse(doc).stringify(), json.stringify());
+
+    // moves to destinations that do not exist
+    doc = "{\"a\":1,\"b\":{}}";
+    json = json::parse(doc);
+    ASSERT_THROW(json::Patch(json::parse("[{\"op\":\"move\",\"from\":\"/a\",\"path\":\"/nope/x\"}]")).apply(json),
+                 json::patch_error);
+    ASSERT_EQ(json::parse(doc).stringify(), json.stringify());
+
+    doc = "{\"a\":[1,2,3]}";
+    json = json::parse(doc);
+    ASSERT_THROW(json::Patch(json::parse("[{\"op\":\"move\",\"from\":\"/a/0\",\"path\":\"/a/7\"}]")).apply(json),
+                 json::patch_error);
+    ASSERT_EQ(json::parse(doc).stringify(), json.stringify());
+
+    // moves replacing the document
+    doc = "{\"a\":{\"b\":1}}";
+    json = json::parse(doc);
+    ASSERT_THROW(json::Patch(json::parse("["
+        "{\"op\":\"move\",\"from\":\"/a\",\"path\":\"\"},"
+        "{\"op\":\"test\",\"path\":\"/x\",\"value\":1}"
+    "]")).apply(json), json::patch_error);
+    ASSERT_EQ(json::parse(doc).stringify(), json.stringify());
+}
+
+TEST(JSON_Patch, EmptyKey) {
+    // "/" is the member "" of the document in every operation
+    std::string doc = "{\"\":1,\"a\":2}";
+    struct apply {
+        static std::string patch(const std::string& doc, const std::string& ops) {
+            Json json = json::parse(doc);
+            json::Patch(json::parse(ops)).apply(json);
+            return json.stringify();
+        }
+    };
+
+    ASSERT_EQ("{\"\":5,\"a\":2}", apply::patch(doc, "[{\"op\":\"add\",\"path\":\"/\",\"value\":5}]"));
+    ASSERT_EQ("{\"\":5,\"a\":2}", apply::patch(doc, "[{\"op\":\"replace\",\"path\":\"/\",\"value\":5}]"));
+    ASSERT_EQ("{\"a\":2}", apply::patch(doc, "[{\"op\":\"remove\",\"path\":\"/\"}]"));
+    ASSERT_EQ(doc, apply::patch(doc, "[{\"op\":\"test\",\"path\":\"/\",\"value\":1}]"));
+    ASSERT_THROW(apply::patch(doc, "[{\"op\":\"test\",\"path\":\"/\",\"value\":{\"\":1,\"a\":2}}]"), json::patch_error);
+    ASSERT_EQ("{\"\":1,\"b\":2}", apply::patch(doc, "[{\"op\":\"move\",\"from\":\"/a\",\"path\":\"/b\"}]"));
+    ASSERT_EQ("{\"a\":2,\"b\":1}", apply::patch(doc, "[{\"op\":\"move\",\"from\":\"/\",\"path\":\"/b\"}]"));
+    ASSERT_EQ("{\"\":2}", apply::patch(doc, "[{\"op\":\"move\",\"from\":\"/a\",\"path\":\"/\"}]"));
+    ASSERT_EQ("{\"\":1,\"a\":1}", apply::patch(doc, "[{\"op\":\"copy\",\"from\":\"/\",\"path\":\"/a\"}]"));
+    ASSERT_THROW(apply::patch("{\"a\":2}", "[{\"op\":\"remove\",\"path\":\"/\"}]"), json::patch_error);
+    ASSERT_THROW(apply::patch("[1]", "[{\"op\":\"replace\",\"path\":\"/\",\"value\":5}]"), json::patch_error);
+
+    // and so it is when rolling back
+    Json json = json::parse(doc);
+    ASSERT_THROW(json::Patch(json::parse("["
+        "{\"op\":\"replace\",\"path\":\"/\",\"value\":5},"
+        "{\"op\":\"move\",\"from\":\"/\",\"path\":\"/b\"},"
+        "{\"op\":\"add\",\"path\":\"/\",\"value\":6},"
+        "{\"op\":\"move\",\"from\":\"/a\",\"path\":\"/\"},"
+        "{\"op\":\"remove\",\"path\":\"/\"},"
+        "{\"op\":\"test\",\"path\":\"/x\",\"value\":1}"
+    "]")).apply(json), json::patch_error);
+    ASSERT_EQ(doc, json.stringify());
+}
+
+TEST(JSON_Patch, Errors) {
+    Json json = json::parse("{\"a\":[1]}");
+
+    ASSERT_THROW(json::Patch(json::parse("{\"op\":\"add\"}")), json::parse_error);
+    ASSERT_THROW(json::Patch(json::parse("[{\"op\":\"nope\",\"path\":\"/a\"}]")), json::parse_error);
+    ASSERT_THROW(json::Patch(json::parse("[{\"op\":\"add\",\"path\":\"/a\"}]")), json::parse_error);
+    ASSERT_THROW(json::Patch(json::parse("[{\"op\":\"move\",\"path\":\"/a\"}]")), json::parse_error);
+    ASSERT_THROW(json::Patch(json::parse("[{\"op\":\"add\",\"path\":\"a\",\"value\":1}]")), json::parse_error);
+
+    ASSERT_THROW(json::Patch(json::parse("[{\"op\":\"add\",\"path\":\"/x/y\",\"value\":1}]")).apply(json),
+                 json::patch_error);
+    ASSERT_THROW(json::Patch(json::parse("[{\"op\":\"add\",\"path\":\"/a/2\",\"value\":1}]")).apply(json),
+                 json::patch_error);
+    ASSERT_THROW(json::Patch(json::parse("[{\"op\":\"add\",\"path\":\"/a/01\",\"value\":1}]")).apply(json),
+                 json::patch_error);
+    ASSERT_THROW(json::Patch(json::parse("[{\"op\":\"replace\",\"path\":\"/b\",\"value\":1}]")).apply(json),
+                 json::patch_error);
+    ASSERT_EQ("{\"a\":[1]}", json.stringify());
+}
+
+static void check_diff(const std::string& from, const std::string& to, size_t max_operations) {
+    Json source = json::parse(from), target = json::parse(to);
+    Json patch = json::diff(source, target);
+    ASSERT_LE(patch.size(), max_operations) << patch.stringify();
+
+    json::Patch(patch).apply(source);
+    ASSERT_EQ(target.stringify(), source.stringify()) << patch.stringify();
+}
+
+TEST(JSON_Patch, Diff) {
+    ASSERT_TRUE(json::diff(json::parse("{\"a\":[1,{\"b\":2}]}"), json::parse("{\"a\":[1,{\"b\":2}]}")).empty());
+
+    check_diff("{\"a\":1,\"b\":2}", "{\"b\":3,\"c\":4}", 3);
+    check_diff("{\"a\":{\"x\":1,\"y\":[1,2]}}", "{\"a\":{\"x\":1,\"y\":[1,2,3]}}", 1);
+    check_diff("[1,2,3,4,5]", "[1,3,4,5]", 1);
+    check_diff("[1,2,3,4,5]", "[0,1,2,3,4,5,6]", 2);
+    check_diff("[1,2,3,4,5]", "[1,2,9,4,5]", 1);
+    check_diff("[{\"id\":1,\"v\":\"a\"},{\"id\":2,\"v\":\"b\"}]", "[{\"id\":1,\"v\":\"a\"},{\"id\":2,\"v\":\"c\"}]", 1);
+    check_diff("[\"a\",\"b\",\"c\",\"d\"]", "[\"d\",\"a\",\"c\",\"x\",\"b\"]", 5);
+    check_diff("{\"a\":[]}", "{\"a\":[1]}", 1);
+    check_diff("{\"a\":1}", "[1]", 1);
+    check_diff("{\"a/b\":1,\"c~d\":2}", "{\"a/b\":2}", 2);
+    check_diff("{\"\":2,\"a/b\":1}", "{\"\":2.5,\"a/b\":1}", 1); // "/" is the whole document
+    check_diff("{\"\":2,\"a\":1}", "{\"a\":1}", 1);
+    check_diff("{\"a\":1}", "{\"\":{},\"a\":1}", 1);
+    check_diff("{\"\":{\"\":1,\"b\":[1]}}", "{\"\":{\"\":2,\"b\":[1,2]}}", 2);
+    ASSERT_TRUE(json::diff(json::parse("{\"n\":1}"), json::parse("{\"n\":1.0}")).empty()); // same number
+}
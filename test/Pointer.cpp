@@ -161,3 +161,159 @@ TEST(JSON_Pointer, WithPropertyInArray) {
     ASSERT_EQ("John Doe", json[json::Pointer("/people/gender=male")]["name"].to_string());
     ASSERT_EQ("Jane Doe", json[json::Pointer("/people/gender=female")]["name"].to_string());
 }
+
+TEST(JSON_Pointer, ArrayIndices) {
+    Json json = json::parse("{\"list\": [ {\"id\": 7}, {\"id\": -1}, {\"id\": \"007\"} ]}");
+
+    ASSERT_EQ(7, json[json::Pointer("/list/0/id")].to_int());
+    ASSERT_EQ("007", json[json::Pointer("/list/id=007/id")].to_string());
+    ASSERT_EQ(-1, json[json::Pointer("/list/id=-1/id")].to_int());
+    ASSERT_EQ(7, json[json::Pointer("/list/id=7/id")].to_int());
+    ASSERT_THROW(json.exists(json::Pointer("/list/id=07")), json::parse_error);
+
+    ASSERT_FALSE(json.exists(json::Pointer("/list/3")));
+    ASSERT_FALSE(json.exists(json::Pointer("/list/99999999999999999999999")));
+    ASSERT_THROW(json.exists(json::Pointer("/list/1x")), json::parse_error);
+    ASSERT_THROW(json.exists(json::Pointer("/list/01")), json::parse_error);
+    ASSERT_THROW(json.exists(json::Pointer("/list/-")), json::parse_error);
+    ASSERT_THROW(json.exists(json::Pointer("/list/id=8")), json::parse_error);
+}
+
+TEST(JSON_Pointer, Find) {
+    std::ifstream stream("test/samples/1.glossary.json");
+    Json value = json::parse(stream);
+    const Json& cvalue = value;
+
+    const Json *found = cvalue.find(json::Pointer("/glossary/GlossDiv/GlossList/GlossEntry/GlossDef/GlossSeeAlso/1"));
+    ASSERT_TRUE(found != nullptr);
+    ASSERT_EQ("XML", found->to_string());
+    ASSERT_EQ(&cvalue[json::Pointer("/glossary/GlossDiv/title")], cvalue.find(json::Pointer("/glossary/GlossDiv/title")));
+
+    ASSERT_TRUE(cvalue.find(json::Pointer("/glossary/UNKNOWN")) == nullptr);
+    ASSERT_TRUE(cvalue.find(json::Pointer("/glossary/title/deeper")) == nullptr);
+    ASSERT_TRUE(cvalue.find(json::Pointer("/glossary/GlossDiv/GlossList/GlossEntry/GlossDef/GlossSeeAlso/2")) == nullptr);
+    ASSERT_THROW(cvalue.find(json::Pointer("/glossary/GlossDiv/GlossList/GlossEntry/GlossDef/GlossSeeAlso/x")),
+                 json::parse_error);
+
+    *value.find(json::Pointer("/glossary/title")) = "changed";
+    ASSERT_EQ("changed", value["glossary"]["title"].to_string());
+}
+
+TEST(JSON_Pointer, PointerSet) {
+    std::ifstream stream("test/samples/2.web_app.json");
+    Json value = json::parse(stream);
+
+    const char *specs[] = {
+        "/web-app/servlet/0/servlet-name",
+        "/web-app/taglib/taglib-uri",
+        "/web-app/servlet/servlet-name=fileServlet/servlet-class",
+        "/web-app/UNKNOWN/0",
+        "/web-app/servlet/0/servlet-name",
+        "/web-app/servlet/99",
+        "",
+    };
+
+    std::vector<json::Pointer> pointers;
+    for (size_t i = 0; i < sizeof(specs)/sizeof(specs[0]); ++i) {
+        pointers.push_back(json::Pointer(specs[i]));
+    }
+
+    json::PointerSet set(pointers);
+    ASSERT_EQ(pointers.size(), set.size());
+    ASSERT_EQ(pointers.size(), set.add(json::Pointer("/web-app/servlet-mapping")));
+
+    std::vector<const Json*> found = set.resolve(value);
+    ASSERT_EQ(set.size(), found.size());
+    for (size_t i = 0; i < pointers.size(); ++i) {
+        ASSERT_EQ(pointers[i].find(value), found[i]) << specs[i];
+    }
+    ASSERT_EQ(&value["web-app"]["servlet-mapping"], found.back());
+    ASSERT_EQ("org.cofax.cds.FileServlet", found[2]->to_string());
+    ASSERT_TRUE(found[3] == nullptr);
+    ASSERT_TRUE(found[5] == nullptr);
+    ASSERT_EQ(&value, found[6]);
+}
+
+TEST(JSON_Pointer, SetAndCreate) {
+    Json json;
+
+    json.set(json::Pointer("/user/name"), "John Doe");
+    json.set(json::Pointer("/user/tags/-"), "admin");
+    json.set(json::Pointer("/user/tags/-"), "dev");
+    json.set(json::Pointer("/user/tags/2"), "ops"); // right past the end, appends
+    json.set(json::Pointer("/user/tags/0"), "root");
+    json.at_or_create(json::Pointer("/user/age")) = 30;
+    ASSERT_EQ("{\"user\":{\"age\":30,\"name\":\"John Doe\",\"tags\":[\"root\",\"dev\",\"ops\"]}}", json.stringify());
+
+    ASSERT_EQ(&json["user"]["name"], &json.at_or_create(json::Pointer("/user/name")));
+
+    json.insert(json::Pointer("/user/tags/1"), "new");
+    json.insert(json::Pointer("/user/tags/-"), "last");
+    ASSERT_EQ("[\"root\",\"new\",\"dev\",\"ops\",\"last\"]", json["user"]["tags"].stringify());
+
+    // the new value may come from the same document
+    json.set(json::Pointer("/copy"), json["user"]);
+    ASSERT_EQ(json["user"].stringify(), json["copy"].stringify());
+
+    ASSERT_THROW(json.set(json::Pointer("/user/tags/9"), 1), std::out_of_range);
+    ASSERT_THROW(json.set(json::Pointer("/user/tags/x"), 1), json::parse_error);
+    ASSERT_THROW(json.set(json::Pointer("/user/name/first"), 1), json::bad_json_type);
+
+    json.set(json::Pointer(""), 1);
+    ASSERT_EQ(1, json.to_int());
+}
+
+TEST(JSON_Pointer, Erase) {
+    Json json = json::parse("{\"a\": {\"b\": [1, 2, 3], \"c\": null}, \"list\": [{\"id\": 1}, {\"id\": 2}]}");
+
+    ASSERT_TRUE(json.erase(json::Pointer("/a/b/1")));
+    ASSERT_EQ("[1,3]", json["a"]["b"].stringify());
+    ASSERT_FALSE(json.erase(json::Pointer("/a/b/5")));
+    ASSERT_TRUE(json.erase(json::Pointer("/a/c")));
+    ASSERT_FALSE(json.erase(json::Pointer("/a/c")));
+    ASSERT_FALSE(json.erase(json::Pointer("/x/y")));
+    ASSERT_TRUE(json.erase(json::Pointer("/list/id=2")));
+    ASSERT_EQ("[{\"id\":1}]", json["list"].stringify());
+    ASSERT_THROW(json.erase(json::Pointer("/a/b/-")), json::parse_error);
+    ASSERT_FALSE(json.erase(json::Pointer("")));
+    ASSERT_EQ("{\"a\":{\"b\":[1,3]},\"list\":[{\"id\":1}]}", json.stringify());
+}
+
+TEST(JSON_Pointer, IndexedPropertyLookup) {
+    Json json;
+    for (int i = 0; i < 1000; ++i) {
+        Json record;
+        record["id"] = i;
+        record["name"] = "record " + json::detail::to_string(i);
+        record["score"] = i / 4.0;
+        json["records"].push_back(record);
+    }
+    json["records"][7]["id"] = "seven";
+    json["records"][8]["id"] = Json::Null;
+    json["records"][9]["id"] = false;
+
+    const Json& cjson = json;
+    for (int i = 10; i < 1000; i += 97) {
+        std::string id = json::detail::to_string(i);
+        ASSERT_EQ(&cjson["records"][i], &cjson[json::Pointer("/records/id=" + id, json::option_index)]);
+        ASSERT_EQ(&cjson["records"][i], &cjson[json::Pointer("/records/id=" + id)]);
+    }
+    ASSERT_EQ(&cjson["records"][7], &cjson[json::Pointer("/records/id=seven", json::option_index)]);
+    ASSERT_EQ(&cjson["records"][8], &cjson[json::Pointer("/records/id=null", json::option_index)]);
+    ASSERT_EQ(&cjson["records"][9], &cjson[json::Pointer("/records/id=false", json::option_index)]);
+    ASSERT_EQ(&cjson["records"][10], &cjson[json::Pointer("/records/score=2.5", json::option_index)]);
+    ASSERT_EQ(&cjson["records"][10], &cjson[json::Pointer("/records/score=2.5")]);
+    ASSERT_EQ(&cjson["records"][4], &cjson[json::Pointer("/records/score=1", json::option_index)]);
+    ASSERT_EQ("record 3", cjson[json::Pointer("/records/name=record 3", json::option_index)]["name"].to_string());
+    ASSERT_THROW(cjson[json::Pointer("/records/id=010", json::option_index)], json::parse_error);
+    ASSERT_THROW(cjson[json::Pointer("/records/id=5000", json::option_index)], json::parse_error);
+
+    // non-const access drops the index
+    json["records"][20]["id"] = -20;
+    ASSERT_EQ(&cjson["records"][20], &cjson[json::Pointer("/records/id=-20", json::option_index)]);
+    ASSERT_THROW(cjson[json::Pointer("/records/id=20", json::option_index)], json::parse_error);
+
+    // copies do not share the index
+    Json copy = json;
+    ASSERT_EQ(&copy["records"][30], copy.find(json::Pointer("/records/id=30", json::option_index)));
+}
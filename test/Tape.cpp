@@ -0,0 +1,193 @@
+/*!
+ * \file Tape.cpp
+ * \author ichramm
+ *
+ * \date 2026-10-19
+ */
+
+#include <gtest/gtest.h>
+
+#include <json.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+static const char *spec =
+    "{\"name\":\"routes\",\"version\":3,\"ratio\":0.5,\"enabled\":true,\"none\":null,"
+    "\"routes\":[{\"id\":1,\"path\":\"/a\"},{\"id\":2,\"path\":\"/b\",\"tags\":[]}],\"empty\":{}}";
+
+TEST(JSON_Tape, Scalars) {
+    json::TapeDocument doc = json::parse_tape(spec);
+    json::TapeValue root = *doc;
+
+    ASSERT_TRUE(root.is_object());
+    ASSERT_EQ(7u, root.size());
+    ASSERT_EQ("routes", root["name"].to_string());
+    ASSERT_STREQ("routes", root["name"].c_str());
+    ASSERT_EQ(3, root["version"].to_int());
+    ASSERT_EQ(3.0, root["version"].to_double());
+    ASSERT_EQ(0.5, root["ratio"].to_double());
+    ASSERT_TRUE(root["enabled"].to_bool());
+    ASSERT_TRUE(root["none"].is_null());
+    ASSERT_TRUE(root["empty"].empty());
+    ASSERT_FALSE(root["routes"].empty());
+
+    ASSERT_THROW(root["name"].to_int(), json::bad_json_type);
+    ASSERT_THROW(root["version"].size(), json::bad_json_type);
+    ASSERT_THROW(root["missing"], json::key_not_found);
+    ASSERT_THROW(root["routes"][2], std::out_of_range);
+    ASSERT_THROW(root["name"]["x"], json::bad_json_type);
+    ASSERT_FALSE(root.find("missing").valid());
+    ASSERT_FALSE(root["name"].find("x").valid());
+    ASSERT_TRUE(root.exists("ratio"));
+
+    ASSERT_TRUE(json::TapeDocument()->is_null());
+    ASSERT_THROW(json::parse_tape("{\"a\":}"), json::parse_error);
+    ASSERT_THROW(json::parse_tape(""), json::parse_error);
+}
+
+TEST(JSON_Tape, Navigation) {
+    json::TapeDocument doc = json::parse_tape(spec);
+    json::TapeValue root = doc.root();
+
+    ASSERT_EQ("/b", root.at(json::Pointer("/routes/1/path")).to_string());
+    ASSERT_EQ("/b", root.at(json::Pointer("/routes/id=2/path")).to_string());
+    ASSERT_THROW(root.find(json::Pointer("/routes/id=3")), json::parse_error); // as with Value
+    ASSERT_FALSE(root.find(json::Pointer("/routes/5")).valid());
+    ASSERT_THROW(root.at(json::Pointer("/routes/5")), json::key_not_found);
+    ASSERT_THROW(root.find(json::Pointer("/routes/01")), json::parse_error);
+
+    // members are kept in document order
+    std::string keys;
+    for (json::TapeValue::const_iterator it = root.begin(); it != root.end(); ++it) {
+        keys += it->key() + " ";
+    }
+    ASSERT_EQ("name version ratio enabled none routes empty ", keys);
+
+    int64_t ids = 0;
+    json::TapeValue routes = root["routes"];
+    for (json::TapeValue::const_iterator it = routes.begin(); it != routes.end(); ++it) {
+        ids += (*it)["id"].to_int();
+        ASSERT_EQ("", it->key());
+    }
+    ASSERT_EQ(3, ids);
+
+    // the last member having a key wins, as with Value
+    std::string dups = "{\"k\":1,\"o\":{\"a\":1},\"k\":2,\"o\":{\"b\":2}}";
+    json::TapeDocument tape = json::parse_tape(dups);
+    Json value = json::parse(dups);
+    ASSERT_EQ(value["k"].to_int(), tape->at("k").to_int());
+    ASSERT_EQ(2, tape->at(json::Pointer("/o/b")).to_int());
+    ASSERT_FALSE(tape->find(json::Pointer("/o/a")).valid());
+    ASSERT_EQ(value, tape->thaw());
+    ASSERT_EQ(value.stringify(), tape->stringify());
+}
+
+TEST(JSON_Tape, Thaw) {
+    Json value = json::parse(spec);
+    json::TapeDocument doc = json::parse_tape(spec);
+
+    ASSERT_EQ(value, doc->thaw());
+    ASSERT_EQ(value.stringify(), doc->stringify());
+    ASSERT_EQ(value["routes"][1].stringify(), (*doc)["routes"][1].stringify());
+
+    std::ifstream stream("test/samples/1.glossary.json");
+    std::stringstream sample;
+    sample << stream.rdbuf();
+    ASSERT_EQ(json::parse(sample.str()), json::parse_tape(sample.str())->thaw());
+
+    // strings with embedded nulls and escapes
+    json::TapeDocument strings = json::parse_tape("[\"a\\u0000b\",\"\\\"q\\\"\",\"\"]");
+    ASSERT_EQ(std::string("a\0b", 3), (*strings)[0].to_string());
+    ASSERT_EQ("\"q\"", (*strings)[1].to_string());
+    ASSERT_EQ("", (*strings)[2].to_string());
+}
+
+TEST(JSON_Tape, Layout) {
+    // one word per scalar, two per double, two per container (opening and closing)
+    json::TapeDocument doc = json::parse_tape("[null,true,1,1.5,\"x\",{\"k\":[]}]");
+    ASSERT_EQ(2u + 1 + 1 + 1 + 2 + 1 + 2 + 1 + 2, doc.count());
+
+    // integers too big for a word take two, like doubles
+    json::TapeDocument numbers = json::parse_tape("[-1,36028797018963967,36028797018963968,-36028797018963968,-36028797018963969]");
+    ASSERT_EQ(2u + 1 + 1 + 2 + 1 + 2, numbers.count());
+    ASSERT_EQ(json::parse("[-1,36028797018963967,36028797018963968,-36028797018963968,-36028797018963969]"), numbers->thaw());
+    ASSERT_EQ(-1.0, (*numbers)[0].to_double());
+
+    // skipping a subtree does not depend on its size
+    std::string big = "[";
+    for (int i = 0; i < 100000; ++i) {
+        big += "[1,2,3],";
+    }
+    big += "{\"last\":true}]";
+    json::TapeDocument nested = json::parse_tape("[" + big + ",42]");
+    ASSERT_EQ(2u, nested->size());
+    ASSERT_EQ(42, (*nested)[1].to_int());
+    ASSERT_EQ(100001u, (*nested)[0].size());
+    ASSERT_TRUE((*nested)[0][100000]["last"].to_bool());
+
+    // the tapes written from values intern the keys
+    std::string records = "[";
+    for (int i = 0; i < 1000; ++i) {
+        records += (i > 0 ? ",{\"identifier\":" : "{\"identifier\":") + std::to_string(i) + "}";
+    }
+    records += "]";
+    ASSERT_LT(json::TapeDocument(json::parse(records)).memory() + 1000 * 10, json::parse_tape(records).memory());
+
+    // the copies share the tape
+    json::TapeDocument copy = doc;
+    ASSERT_EQ(doc.memory(), copy.memory());
+    ASSERT_EQ((*doc)[4].c_str(), (*copy)[4].c_str());
+}
+
+TEST(JSON_Tape, Snapshot) {
+    const std::string path = "build/Tape.snapshot";
+
+    Json value = json::parse(spec);
+    json::save_snapshot(value, path);
+
+    json::TapeDocument doc = json::open_snapshot(path);
+    ASSERT_EQ(value, doc->thaw());
+    ASSERT_EQ("/b", doc->at(json::Pointer("/routes/id=2/path")).to_string());
+    ASSERT_EQ(0.5, (*doc)["ratio"].to_double());
+    ASSERT_EQ(json::TapeDocument(value).count(), doc.count());
+    ASSERT_EQ(value, json::TapeDocument(value)->thaw());
+
+    // tapes are saved as they are, the document stays valid after the file is replaced
+    json::save_snapshot(json::parse_tape("[1,\"two\",{\"three\":3.5}]"), path);
+    json::TapeDocument other = json::open_snapshot(path, false);
+    ASSERT_EQ("two", (*other)[1].to_string());
+    ASSERT_EQ(3.5, other->at(json::Pointer("/2/three")).to_double());
+    ASSERT_EQ("routes", (*doc)["name"].to_string());
+
+    json::save_snapshot(json::TapeDocument(), path);
+    ASSERT_TRUE(json::open_snapshot(path)->is_null());
+    json::save_snapshot(Json("scalar"), path);
+    ASSERT_EQ("scalar", json::open_snapshot(path)->to_string());
+
+    ASSERT_THROW(json::open_snapshot("build/missing.snapshot"), json::snapshot_error);
+    ASSERT_THROW(json::open_snapshot("test/samples/1.glossary.json"), json::snapshot_error);
+    ASSERT_THROW(json::save_snapshot(value, "build/missing/Tape.snapshot"), json::snapshot_error);
+
+    std::string content;
+    json::save_snapshot(value, path);
+    {
+        std::ifstream stream(path.c_str(), std::ios::binary);
+        std::stringstream buffer;
+        buffer << stream.rdbuf();
+        content = buffer.str();
+    }
+
+    // a flipped byte within a string
+    std::string corrupted = content;
+    corrupted[corrupted.size() - 3] ^= 1;
+    std::ofstream(path.c_str(), std::ios::binary).write(corrupted.data(), corrupted.size());
+    ASSERT_THROW(json::open_snapshot(path), json::snapshot_error);
+    ASSERT_NO_THROW(json::open_snapshot(path, false));
+
+    std::ofstream(path.c_str(), std::ios::binary).write(content.data(), content.size() - 1);
+    ASSERT_THROW(json::open_snapshot(path, false), json::snapshot_error);
+
+    std::remove(path.c_str());
+}